@@ -0,0 +1,135 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <string>
+#include <vector>
+
+#include "../helpers.h"
+#include "vapor/analyzer.h"
+#include "vapor/analyzer/types/sized_integer_value.h"
+#include "vapor/parser.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+// the example program of the driver, with the arguments of the call that gets folded replaced
+std::u32string program(std::size_t m, std::size_t n)
+{
+    return UR"program(module folding
+{
+    let int64 = sized_int(64);
+
+    let mn = struct { let m : int64; let n : int64; };
+
+    function ackermann(args : mn) -> int64
+    {
+        if (args.m == 0)
+        {
+            return args.n + 1;
+        }
+
+        if (args.n == 0)
+        {
+            return ackermann(args{ .m = .m - 1, .n = 1 });
+        }
+
+        return ackermann(args{ .m = .m - 1, .n = ackermann(args{ .n = .n - 1 }) });
+    }
+
+    let value = ackermann(mn{ )program"
+        + utf32(std::to_string(m)) + U", " + utf32(std::to_string(n)) + UR"program( });
+})program";
+}
+
+// the number of calls the fold of ackermann(m, n) evaluates
+std::size_t calls(std::size_t m, std::size_t n)
+{
+    std::size_t count = 0;
+    std::vector<std::size_t> stack{ m };
+    while (!stack.empty())
+    {
+        ++count;
+        m = stack.back();
+        stack.pop_back();
+
+        if (m == 0)
+        {
+            ++n;
+        }
+        else if (n == 0)
+        {
+            stack.push_back(m - 1);
+            n = 1;
+        }
+        else
+        {
+            stack.push_back(m - 1);
+            stack.push_back(m);
+            --n;
+        }
+    }
+
+    return count;
+}
+
+void ackermann(state & st, std::size_t m, std::size_t n)
+{
+    parser::ast parsed{ program(m, n), lexer::engine::synchronous };
+
+    st.run([&] {
+        analyzer::ast tree{ parsed };
+        tree.simplify();
+        return calls(m, n);
+    });
+}
+
+// the arithmetic the folds do, on the representation of the constants of sized integers and on the big integers they used
+// to be kept as
+template<typename T>
+void arithmetic(state & st)
+{
+    st.run([] {
+        T sum = 0;
+        for (std::int64_t i = 0; i < 100000; ++i)
+        {
+            sum = sum + T{ i } * T{ 3 } - T{ 1 };
+        }
+
+        // three operations per step; the result is used, so that the loop can't be thrown away
+        return sum != T{ 0 } ? std::size_t{ 300000 } : std::size_t{ 0 };
+    });
+}
+
+auto registered = [] {
+    for (auto && arguments : std::vector<std::pair<std::size_t, std::size_t>>{ { 2, 3 }, { 2, 10 }, { 3, 2 }, { 3, 3 } })
+    {
+        add_benchmark("analyzer/folding/ackermann/" + std::to_string(arguments.first) + "-" + std::to_string(arguments.second),
+            [arguments](state & st) { ackermann(st, arguments.first, arguments.second); });
+    }
+
+    add_benchmark("analyzer/folding/arithmetic/sized_integer_value", [](state & st) { arithmetic<analyzer::sized_integer_value>(st); });
+    add_benchmark("analyzer/folding/arithmetic/cpp_int", [](state & st) { arithmetic<boost::multiprecision::cpp_int>(st); });
+    return 0;
+}();
+}
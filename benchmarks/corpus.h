@@ -0,0 +1,63 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <string>
+
+namespace reaver::vapor::benchmark
+{
+inline namespace _v1
+{
+    // a single, large module built out of a repeated, representative unit
+    inline const std::u32string & large_module()
+    {
+        static const std::u32string unit = UR"program(
+    let mn = struct { let m : int32; let n : int32; };
+
+    function ackermann(args : mn) -> int32
+    {
+        if (args.m == 0)
+        {
+            return args.n + 1;
+        }
+
+        return ackermann(args{ .m = .m - 1, .n = ackermann(args{ .n = .n - 1 }) });
+    }
+
+    let entry = λ(arg : int32) -> int32 => ackermann(mn{ arg, arg + 1 }) - 1;
+)program";
+
+        static const std::u32string program = [] {
+            std::u32string ret = U"module benchmark {";
+            for (std::size_t i = 0; i < 2000; ++i)
+            {
+                ret += unit;
+            }
+            ret += U"}";
+            return ret;
+        }();
+
+        return program;
+    }
+}
+}
@@ -0,0 +1,188 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <reaver/future.h>
+#include <reaver/future_get.h>
+
+#include "helpers.h"
+#include "vapor/analyzer.h"
+#include "vapor/parser.h"
+#include "vapor/work_stealing_executor.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+// counts the tasks pushed to the executor it wraps
+class counting_executor : public reaver::executor
+{
+public:
+    counting_executor(std::shared_ptr<reaver::executor> executor) : _executor{ std::move(executor) }
+    {
+    }
+
+    virtual void push(reaver::function<void()> f) override
+    {
+        _tasks.fetch_add(1, std::memory_order_relaxed);
+        _executor->push(std::move(f));
+    }
+
+    std::size_t tasks() const
+    {
+        return _tasks.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::shared_ptr<reaver::executor> _executor;
+    std::atomic<std::size_t> _tasks{ 0 };
+};
+
+// a binary tree of continuations, each of which starts the ones of its children, like the simplification of an AST does
+reaver::future<> visit(std::size_t depth, std::atomic<std::size_t> & nodes)
+{
+    return reaver::make_ready_future().then([depth, &nodes]() -> reaver::future<> {
+        nodes.fetch_add(1, std::memory_order_relaxed);
+
+        if (depth == 0)
+        {
+            return reaver::make_ready_future();
+        }
+
+        return reaver::when_all(std::vector<reaver::future<>>{ visit(depth - 1, nodes), visit(depth - 1, nodes) });
+    });
+}
+
+// copies of the example program of the driver, each folding its own calls
+const std::u32string copy_template = UR"program(
+    let int32_$ = sized_int(32);
+    let mn_$ = struct { let m : int32_$; let n : int32_$; };
+
+    function ackermann_$(args : mn_$) -> int32_$
+    {
+        if (args.m == 0)
+        {
+            return args.n + 1;
+        }
+
+        if (args.n == 0)
+        {
+            return ackermann_$(args{ .m = .m - 1, .n = 1 });
+        }
+
+        return ackermann_$(args{ .m = .m - 1, .n = ackermann_$(args{ .n = .n - 1 }) });
+    }
+
+    let value_$ = ackermann_$(mn_${ 2, 1 });
+)program";
+
+const std::u32string & program()
+{
+    static auto program = [] {
+        std::u32string program = U"module executor\n{";
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            auto number = utf32(std::to_string(i));
+            for (auto c : copy_template)
+            {
+                if (c == U'$')
+                {
+                    program += number;
+                    continue;
+                }
+
+                program += c;
+            }
+        }
+        program += U"}\n";
+        return program;
+    }();
+
+    return program;
+}
+
+template<typename F>
+void with_executor(state & st, std::shared_ptr<reaver::executor> executor, F && body)
+{
+    auto counting = std::make_shared<counting_executor>(executor);
+
+    auto original = reaver::default_executor();
+    reaver::default_executor(counting);
+
+    body();
+
+    reaver::default_executor(original);
+
+    // the warm-up run pushes tasks too
+    st.report("tasks/iter", double(counting->tasks()) / (st.iterations() + 1));
+    if (auto work_stealing = std::dynamic_pointer_cast<work_stealing_executor>(executor))
+    {
+        auto statistics = work_stealing->get_statistics();
+        st.report("stolen/iter", double(statistics.stolen) / (st.iterations() + 1));
+    }
+}
+
+void tree(state & st, std::shared_ptr<reaver::executor> executor)
+{
+    with_executor(st, std::move(executor), [&] {
+        st.run([] {
+            std::atomic<std::size_t> nodes{ 0 };
+            reaver::get(visit(14, nodes));
+            return nodes.load();
+        });
+    });
+}
+
+void simplify(state & st, std::shared_ptr<reaver::executor> executor)
+{
+    parser::ast parsed{ program(), lexer::engine::synchronous };
+
+    with_executor(st, std::move(executor), [&] {
+        st.run([&] {
+            analyzer::ast tree{ parsed };
+            tree.simplify();
+            // the number of copies of the function that's being folded
+            return std::size_t{ 16 };
+        });
+    });
+}
+
+auto registered = [] {
+    for (std::size_t threads = 1; threads <= std::max(std::thread::hardware_concurrency(), 2u); threads *= 2)
+    {
+        auto suffix = "/threads-" + std::to_string(threads);
+
+        add_benchmark("executor/tree/thread_pool" + suffix, [threads](state & st) { tree(st, reaver::make_executor<reaver::thread_pool>(threads)); });
+        add_benchmark("executor/tree/work_stealing" + suffix, [threads](state & st) { tree(st, std::make_shared<work_stealing_executor>(threads)); });
+
+        add_benchmark(
+            "executor/simplify/thread_pool" + suffix, [threads](state & st) { simplify(st, reaver::make_executor<reaver::thread_pool>(threads)); });
+        add_benchmark("executor/simplify/work_stealing" + suffix, [threads](state & st) { simplify(st, std::make_shared<work_stealing_executor>(threads)); });
+    }
+    return 0;
+}();
+}
@@ -0,0 +1,195 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace reaver::vapor::benchmark
+{
+inline namespace _v1
+{
+    struct corpus_options
+    {
+        std::size_t functions = 0;
+        std::size_t structs = 0;
+        // how deeply the expressions in function bodies nest
+        std::size_t expression_depth = 2;
+        // lines of comments before every declaration
+        std::size_t comment_lines = 0;
+        std::uint32_t seed = 1;
+    };
+
+    // generates a syntactically valid module; the same options always give the same module
+    inline std::u32string generate_module(const corpus_options & options)
+    {
+        std::mt19937 rng{ options.seed };
+        auto pick = [&](std::size_t n) { return rng() % n; };
+
+        std::u32string ret = U"module synthetic\n{\n    let int32 = sized_int(32);\n";
+
+        auto number = [](std::size_t n) {
+            auto str = std::to_string(n);
+            return std::u32string{ str.begin(), str.end() };
+        };
+
+        auto comment = [&](const std::u32string & indent) {
+            for (std::size_t i = 0; i < options.comment_lines; ++i)
+            {
+                switch (pick(3))
+                {
+                    case 0:
+                        ret += indent + U"// a line comment, with a \"string\" and an operator -> in it\n";
+                        break;
+                    case 1:
+                        ret += indent + U"/* a block comment, with // a line comment in it */\n";
+                        break;
+                    case 2:
+                        ret += indent + U"/*\n" + indent + U" * a multi-line block comment\n" + indent + U" */\n";
+                        break;
+                }
+            }
+        };
+
+        const char32_t * binary_operators[] = { U" + ", U" - ", U" * ", U" / ", U" == ", U" != ", U" && ", U" | " };
+
+        auto leaf = [&]() -> std::u32string {
+            switch (pick(3))
+            {
+                case 0:
+                    return U"a";
+                case 1:
+                    return U"b";
+                default:
+                    return number(pick(1000));
+            }
+        };
+
+        // calls only go to the functions defined before; every step nests the expression built so far one level deeper
+        auto expression = [&](std::size_t depth, std::size_t callees) {
+            std::u32string expr = leaf();
+
+            for (std::size_t i = 0; i < depth; ++i)
+            {
+                auto op = binary_operators[pick(sizeof(binary_operators) / sizeof(*binary_operators))];
+
+                if (callees && pick(2))
+                {
+                    expr = leaf() + op + U"f" + number(pick(callees)) + U"(" + expr + U", " + leaf() + U")";
+                }
+                else if (options.structs && pick(2))
+                {
+                    expr = leaf() + op + U"s" + number(pick(options.structs)) + U"{ " + expr + U", " + leaf() + U" }";
+                }
+                else
+                {
+                    expr = U"-" + leaf() + op + expr;
+                }
+            }
+
+            return expr;
+        };
+
+        for (std::size_t i = 0; i < options.structs; ++i)
+        {
+            ret += U"\n";
+            comment(U"    ");
+            ret += U"    let s" + number(i) + U" = struct\n    {\n";
+            for (std::size_t member = 0, count = 1 + pick(8); member < count; ++member)
+            {
+                ret += U"        let m" + number(member) + U" : int32;\n";
+            }
+            ret += U"    };\n";
+        }
+
+        for (std::size_t i = 0; i < options.functions; ++i)
+        {
+            ret += U"\n";
+            comment(U"    ");
+
+            if (pick(4) == 0)
+            {
+                ret += U"    let f" + number(i) + U" = λ(a : int32, b : int32) -> int32 => " + expression(options.expression_depth, i) + U";\n";
+                continue;
+            }
+
+            ret += U"    function f" + number(i) + U"(a : int32, b : int32) -> int32\n    {\n";
+            ret += U"        if (a == " + number(pick(10)) + U")\n        {\n";
+            comment(U"            ");
+            ret += U"            return " + expression(options.expression_depth, i) + U";\n        }\n\n";
+
+            for (std::size_t local = 0, count = pick(4); local < count; ++local)
+            {
+                comment(U"        ");
+                ret += U"        let l" + number(local) + U" = " + expression(options.expression_depth, i) + U";\n";
+            }
+
+            ret += U"        return " + expression(options.expression_depth, i) + U";\n    }\n";
+        }
+
+        ret += U"}\n";
+        return ret;
+    }
+
+    struct synthetic_corpus
+    {
+        std::string name;
+        std::u32string source;
+    };
+
+    // the shapes of code the lexer and the parser are measured on
+    inline const std::vector<synthetic_corpus> & synthetic_corpora()
+    {
+        static const std::vector<synthetic_corpus> corpora = [] {
+            std::vector<synthetic_corpus> ret;
+
+            corpus_options functions;
+            functions.functions = 5000;
+            ret.push_back({ "functions", generate_module(functions) });
+
+            corpus_options structs;
+            structs.structs = 20000;
+            ret.push_back({ "structs", generate_module(structs) });
+
+            corpus_options nesting;
+            nesting.functions = 500;
+            nesting.expression_depth = 40;
+            nesting.structs = 40;
+            ret.push_back({ "nesting", generate_module(nesting) });
+
+            corpus_options comments;
+            comments.functions = 2000;
+            comments.structs = 2000;
+            comments.comment_lines = 8;
+            ret.push_back({ "comments", generate_module(comments) });
+
+            return ret;
+        }();
+
+        return corpora;
+    }
+}
+}
@@ -0,0 +1,130 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/allocations.h"
+
+namespace reaver::vapor::benchmark
+{
+inline namespace _v1
+{
+    class state
+    {
+    public:
+        state(std::size_t iterations) : _iterations{ iterations }
+        {
+        }
+
+        // F is expected to return the number of items (tokens, nodes...) it has processed
+        // the first invocation is a warm-up run and is not measured
+        template<typename F>
+        void run(F && f)
+        {
+            f();
+
+            std::size_t items = 0;
+            auto allocations = allocation_count();
+            auto bytes = allocated_byte_count();
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < _iterations; ++i)
+            {
+                items += f();
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            _seconds = std::chrono::duration<double>(end - start).count();
+            _items = items;
+            _allocations = allocation_count() - allocations;
+            _allocated_bytes = allocated_byte_count() - bytes;
+        }
+
+        void report(std::string name, double value)
+        {
+            _counters.emplace_back(std::move(name), value);
+        }
+
+        std::size_t iterations() const
+        {
+            return _iterations;
+        }
+
+        double seconds() const
+        {
+            return _seconds;
+        }
+
+        std::size_t items() const
+        {
+            return _items;
+        }
+
+        std::size_t allocations() const
+        {
+            return _allocations;
+        }
+
+        std::size_t allocated_bytes() const
+        {
+            return _allocated_bytes;
+        }
+
+        const auto & counters() const
+        {
+            return _counters;
+        }
+
+    private:
+        std::size_t _iterations;
+        double _seconds = 0;
+        std::size_t _items = 0;
+        std::size_t _allocations = 0;
+        std::size_t _allocated_bytes = 0;
+        std::vector<std::pair<std::string, double>> _counters;
+    };
+
+    struct benchmark_case
+    {
+        std::string name;
+        std::function<void(state &)> body;
+    };
+
+    inline std::vector<benchmark_case> & benchmarks()
+    {
+        static std::vector<benchmark_case> registry;
+        return registry;
+    }
+
+    inline bool add_benchmark(std::string name, std::function<void(state &)> body)
+    {
+        benchmarks().push_back({ std::move(name), std::move(body) });
+        return true;
+    }
+}
+}
@@ -0,0 +1,54 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <string>
+
+#include "../generator.h"
+#include "../helpers.h"
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+std::size_t lex(const std::u32string & source)
+{
+    std::size_t count = 0;
+    for (lexer::iterator it{ source.begin(), source.end(), lexer::engine::synchronous, lexer::handoff_mode::chunked }; it; ++it)
+    {
+        ++count;
+    }
+    return count;
+}
+
+auto corpora = [] {
+    for (auto && corpus : synthetic_corpora())
+    {
+        add_benchmark("lexer/corpus/" + corpus.name, [&](state & st) {
+            st.run([&] { return lex(corpus.source); });
+            st.report("characters/s", corpus.source.size() * st.iterations() / st.seconds());
+        });
+    }
+    return true;
+}();
+}
@@ -0,0 +1,51 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <string>
+
+#include "../helpers.h"
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+// the typical parser test or compile server request: lots of tiny, short-lived iterators
+std::size_t lex_snippets(lexer::engine engine)
+{
+    static const std::u32string snippet = UR"(let entry = λ(arg : int32) -> int32 => arg + 1;)";
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        for (lexer::iterator it{ snippet.begin(), snippet.end(), engine }; it; ++it)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+auto threaded = add_benchmark("lexer/engine/threaded-snippets", [](state & st) { st.run([] { return lex_snippets(lexer::engine::threaded); }); });
+auto synchronous = add_benchmark("lexer/engine/synchronous-snippets", [](state & st) { st.run([] { return lex_snippets(lexer::engine::synchronous); }); });
+}
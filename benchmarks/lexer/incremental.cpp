@@ -0,0 +1,86 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <string>
+#include <vector>
+
+#include "../corpus.h"
+#include "../helpers.h"
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+std::vector<lexer::token> lex(const std::u32string & source)
+{
+    std::vector<lexer::token> tokens;
+    for (lexer::iterator it{ source.begin(), source.end(), lexer::engine::synchronous, lexer::handoff_mode::chunked }; it; ++it)
+    {
+        tokens.push_back(*it);
+    }
+    return tokens;
+}
+
+// a keystroke in the middle of the file, typing a character into an identifier and then deleting it;
+// items are keystrokes
+struct editor
+{
+    editor() : text{ large_module() }, tokens{ lex(text) }, offset{ static_cast<std::uint32_t>(text.find(U"let ", text.size() / 2) + 4) }
+    {
+    }
+
+    std::size_t type(bool incremental)
+    {
+        for (auto && edit : { lexer::text_edit{ offset, offset, U"x" }, lexer::text_edit{ offset, offset + 1, U"" } })
+        {
+            lexer::apply_edit(text, edit);
+
+            if (incremental)
+            {
+                lexer::relex(tokens, text, edit);
+            }
+            else
+            {
+                tokens = lex(text);
+            }
+        }
+
+        return 2;
+    }
+
+    std::u32string text;
+    std::vector<lexer::token> tokens;
+    std::uint32_t offset;
+};
+
+auto full = add_benchmark("lexer/incremental/full", [](state & st) {
+    editor e;
+    st.run([&] { return e.type(false); });
+});
+
+auto incremental = add_benchmark("lexer/incremental/relex", [](state & st) {
+    editor e;
+    st.run([&] { return e.type(true); });
+});
+}
@@ -0,0 +1,79 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <string>
+#include <thread>
+
+#include <reaver/future.h>
+
+#include "../corpus.h"
+#include "../helpers.h"
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+const std::u32string & source()
+{
+    static const std::u32string program = [] {
+        std::u32string ret;
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            ret += large_module();
+            ret += U'\n';
+        }
+        return ret;
+    }();
+
+    return program;
+}
+
+std::size_t lex(lexer::engine engine)
+{
+    std::size_t count = 0;
+    for (lexer::iterator it{ source().begin(), source().end(), engine, lexer::handoff_mode::chunked }; it; ++it)
+    {
+        ++count;
+    }
+    return count;
+}
+
+auto serial = add_benchmark("lexer/parallel/serial", [](state & st) { st.run([] { return lex(lexer::engine::synchronous); }); });
+
+// the thread running the benchmark lexes too, so the pool gets one thread less than the count in the name
+auto registered = [] {
+    for (std::size_t threads = 2; threads <= std::max(std::thread::hardware_concurrency(), 2u); threads *= 2)
+    {
+        add_benchmark("lexer/parallel/threads-" + std::to_string(threads), [threads](state & st) {
+            auto original = reaver::default_executor();
+            reaver::default_executor(reaver::make_executor<reaver::thread_pool>(threads - 1));
+
+            st.run([] { return lex(lexer::engine::parallel); });
+
+            reaver::default_executor(original);
+        });
+    }
+    return 0;
+}();
+}
@@ -0,0 +1,111 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <string>
+
+#include "../helpers.h"
+#include "vapor/lexer.h"
+#include "vapor/lexer/scan.h"
+#include "vapor/utf.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+// long identifiers, deep indentation and lots of comments: the runs the scanners are for
+const std::u32string & source()
+{
+    static const std::u32string unit = UR"program(
+    /*
+     * Computes the Ackermann function of the two members of the argument.
+     * This grows very, very quickly; don't call it with anything but small numbers,
+     * unless what you're after is testing the patience of whoever is running this.
+     */
+    function ackermann_function_of_the_members(ackermann_arguments_structure : ackermann_arguments) -> int32
+    {
+        // the base case of the recursion
+        if (ackermann_arguments_structure.first_argument == 0)
+        {
+            return ackermann_arguments_structure.second_argument + 1; // m == 0
+        }
+
+        // both of the recursive cases at once, with nested structure updates
+        return ackermann_function_of_the_members(ackermann_arguments_structure{
+            .first_argument = .first_argument - 1,
+            .second_argument = ackermann_function_of_the_members(ackermann_arguments_structure{ .second_argument = .second_argument - 1 })
+        });
+    }
+)program";
+
+    static const std::u32string program = [] {
+        std::u32string ret = U"module benchmark {";
+        for (std::size_t i = 0; i < 2000; ++i)
+        {
+            ret += unit;
+        }
+        ret += U"}";
+        return ret;
+    }();
+
+    return program;
+}
+
+template<typename Iter>
+std::size_t lex(lexer::scan::isa set, Iter begin, Iter end, file_id file = unknown_file)
+{
+    auto original = lexer::scan::selected();
+    lexer::scan::select(set);
+
+    std::size_t count = 0;
+    for (lexer::iterator it{ begin, end, file, lexer::engine::synchronous, lexer::handoff_mode::chunked }; it; ++it)
+    {
+        ++count;
+    }
+
+    lexer::scan::select(original);
+    return count;
+}
+
+void add(lexer::scan::isa set, const char * name)
+{
+    if (!lexer::scan::supported(set))
+    {
+        return;
+    }
+
+    add_benchmark(std::string{ "lexer/scan/utf32/" } + name, [=](state & st) { st.run([=] { return lex(set, source().begin(), source().end()); }); });
+
+    add_benchmark(std::string{ "lexer/scan/utf8/" } + name, [=](state & st) {
+        static const std::string utf8_source = utf8(source());
+        auto end = utf8_source.data() + utf8_source.size();
+        st.run([=] { return lex(set, utf8_iterator{ utf8_source.data(), end }, utf8_iterator{ end, end }); });
+    });
+}
+
+auto registered = [] {
+    add(lexer::scan::isa::scalar, "scalar");
+    add(lexer::scan::isa::sse2, "sse2");
+    add(lexer::scan::isa::avx2, "avx2");
+    return 0;
+}();
+}
@@ -0,0 +1,52 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <string>
+#include <vector>
+
+#include "../corpus.h"
+#include "../helpers.h"
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+// collects the whole token stream, the way the parser keeps it around; the allocations per item
+// reported for this benchmark are what each token costs on top of the storage of the vector
+std::size_t collect_tokens()
+{
+    std::vector<lexer::token> tokens;
+    tokens.reserve(1 << 18);
+
+    auto & source = large_module();
+    for (lexer::iterator it{ source.begin(), source.end(), lexer::engine::synchronous, lexer::handoff_mode::chunked }; it; ++it)
+    {
+        tokens.push_back(*it);
+    }
+
+    return tokens.size();
+}
+
+auto collect = add_benchmark("lexer/tokens/collect", [](state & st) { st.run(collect_tokens); });
+}
@@ -0,0 +1,95 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "../corpus.h"
+#include "../helpers.h"
+#include "vapor/lexer.h"
+#include "vapor/mapped_file.h"
+#include "vapor/utf8_iterator.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+struct corpus_file
+{
+    corpus_file() : path{ (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vapor-bench-%%%%-%%%%.vprl")).string() }
+    {
+        std::ofstream out{ path };
+        out << utf8(large_module());
+    }
+
+    ~corpus_file()
+    {
+        boost::filesystem::remove(path);
+    }
+
+    std::string path;
+};
+
+const std::string & corpus_path()
+{
+    static const corpus_file file;
+    return file.path;
+}
+
+// what the driver used to do: read the file, convert it to UTF-32, lex that
+std::size_t convert_and_lex()
+{
+    std::ifstream in{ corpus_path() };
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    auto source = utf32(buffer.str());
+
+    std::size_t count = 0;
+    for (lexer::iterator it{ source.begin(), source.end(), lexer::engine::synchronous, lexer::handoff_mode::chunked }; it; ++it)
+    {
+        ++count;
+    }
+    return count;
+}
+
+std::size_t map_and_lex()
+{
+    mapped_file file{ corpus_path() };
+    auto end = file.data() + file.size();
+
+    std::size_t count = 0;
+    for (lexer::iterator it{ utf8_iterator{ file.data(), end }, utf8_iterator{ end, end }, unknown_file, lexer::engine::synchronous, lexer::handoff_mode::chunked };
+         it;
+         ++it)
+    {
+        ++count;
+    }
+    return count;
+}
+
+auto convert = add_benchmark("lexer/utf8/convert-then-lex", [](state & st) { st.run(convert_and_lex); });
+auto mapped = add_benchmark("lexer/utf8/mapped", [](state & st) { st.run(map_and_lex); });
+}
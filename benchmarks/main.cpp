@@ -0,0 +1,115 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <sys/resource.h>
+
+#include <reaver/future.h>
+#include <reaver/logger.h>
+
+#include "helpers.h"
+
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+// makes the kernel start tracking the peak resident set size anew; returns false if that's not supported,
+// in which case the peak is the one of the whole process so far
+bool reset_peak_rss()
+{
+    std::ofstream clear_refs{ "/proc/self/clear_refs" };
+    return static_cast<bool>(clear_refs << "5" << std::flush);
+}
+
+// in kilobytes
+std::size_t peak_rss()
+{
+    std::ifstream status{ "/proc/self/status" };
+    for (std::string line; std::getline(status, line);)
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return std::stoul(line.substr(6));
+        }
+    }
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+}
+
+int main(int argc, char ** argv) try
+{
+    reaver::default_executor(reaver::make_executor<reaver::thread_pool>(1));
+    reaver::logger::default_logger().set_level(reaver::logger::error);
+
+    std::size_t iterations = 10;
+    std::string filter;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            iterations = std::stoul(argv[++i]);
+            continue;
+        }
+
+        filter = argv[i];
+    }
+
+    for (auto && bench : benchmarks())
+    {
+        if (bench.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        state st{ iterations };
+        auto peak_is_per_benchmark = reset_peak_rss();
+        bench.body(st);
+        auto peak = peak_rss();
+
+        std::cout << std::left << std::setw(48) << bench.name << std::right << std::fixed << std::setprecision(3) << std::setw(12)
+                  << st.seconds() * 1000 / st.iterations() << " ms/iter" << std::setw(16) << std::setprecision(0) << st.items() / st.seconds() << " items/s"
+                  << std::setw(10) << std::setprecision(2) << double(st.allocations()) / st.items() << " allocs/item" << std::setw(14)
+                  << double(st.allocated_bytes()) / st.items() << " B/item" << std::setw(10) << peak / 1024 << (peak_is_per_benchmark ? " MB peak" : " MB peak (process)");
+
+        for (auto && counter : st.counters())
+        {
+            std::cout << "  " << counter.first << ": " << std::setprecision(2) << counter.second;
+        }
+
+        std::cout << '\n';
+    }
+}
+
+catch (std::exception & e)
+{
+    std::cerr << e.what() << '\n';
+    return 2;
+}
@@ -0,0 +1,70 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <string>
+
+#include "../helpers.h"
+#include "vapor/parser.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+std::u32string chain(std::size_t length, std::initializer_list<std::u32string> operators)
+{
+    std::u32string ret = U"a";
+    auto op = operators.begin();
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        ret += U" " + *op + U" a";
+        if (++op == operators.end())
+        {
+            op = operators.begin();
+        }
+    }
+    ret += U";";
+    return ret;
+}
+
+void parse(state & st, std::u32string source, std::size_t operators)
+{
+    lexer::iterator head{ source.begin(), source.end(), lexer::engine::synchronous, lexer::handoff_mode::chunked };
+    for (auto it = head; it; ++it)
+    {
+    }
+
+    st.run([&] {
+        parser::arena memory;
+        parser::arena_scope scope{ &memory };
+
+        parser::context ctx;
+        ctx.begin = head;
+        parser::parse_expression(ctx);
+        return operators;
+    });
+}
+
+auto left = add_benchmark("parser/binary/left-associative", [](state & st) { parse(st, chain(2000, { U"+" }), 2000); });
+auto right = add_benchmark("parser/binary/right-associative", [](state & st) { parse(st, chain(2000, { U"=" }), 2000); });
+auto mixed = add_benchmark("parser/binary/mixed-precedence", [](state & st) { parse(st, chain(2000, { U"*", U"+", U"<", U"&&", U"-" }), 2000); });
+}
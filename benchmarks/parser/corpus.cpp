@@ -0,0 +1,82 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <sstream>
+#include <string>
+
+#include "../generator.h"
+#include "../helpers.h"
+#include "vapor/parser.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+// every node prints its address after an " @ "
+std::size_t count_nodes(const parser::ast & ast)
+{
+    std::ostringstream os;
+    os << ast;
+    auto dump = os.str();
+
+    std::size_t count = 0;
+    for (auto pos = dump.find(" @ "); pos != std::string::npos; pos = dump.find(" @ ", pos + 3))
+    {
+        ++count;
+    }
+    return count;
+}
+
+void parse(state & st, const std::u32string & source, parser::node_allocation allocation, parser::body_parsing bodies = parser::body_parsing::eager)
+{
+    // lex everything up front; the copy of the first iterator keeps the whole token list alive, so the parser
+    // only ever walks already lexed tokens
+    lexer::iterator head{ source.begin(), source.end(), lexer::engine::synchronous, lexer::handoff_mode::chunked };
+    std::size_t tokens = 0;
+    for (auto it = head; it; ++it)
+    {
+        ++tokens;
+    }
+
+    auto nodes = count_nodes(parser::ast{ head });
+
+    st.run([&] {
+        parser::ast ast{ head, {}, allocation, parser::module_parsing::sequential, bodies };
+        return nodes;
+    });
+    st.report("tokens/s", tokens * st.iterations() / st.seconds());
+}
+
+auto corpora = [] {
+    for (auto && corpus : synthetic_corpora())
+    {
+        add_benchmark("parser/corpus/" + corpus.name, [&](state & st) { parse(st, corpus.source, parser::node_allocation::arena); });
+        add_benchmark("parser/corpus/" + corpus.name + "/heap", [&](state & st) { parse(st, corpus.source, parser::node_allocation::heap); });
+        // nothing looks into the bodies here, so this measures only finding where they end; the items are still the nodes of a full parse
+        add_benchmark("parser/corpus/" + corpus.name + "/deferred", [&](state & st) {
+            parse(st, corpus.source, parser::node_allocation::arena, parser::body_parsing::deferred);
+        });
+    }
+    return true;
+}();
+}
@@ -0,0 +1,72 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <string>
+
+#include "../generator.h"
+#include "../helpers.h"
+#include "vapor/parser.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+parser::module parse(const std::u32string & source)
+{
+    parser::context ctx;
+    ctx.begin = lexer::iterator{ source.begin(), source.end(), lexer::engine::synchronous };
+    return parser::parse_module(ctx);
+}
+
+// compares reparsing a module after inserting a space in the middle of it with parsing it from scratch; every iteration of
+// the reparse goes back and forth between the two texts, to always have the previous module at hand; items are characters
+auto corpora = [] {
+    for (auto && corpus : synthetic_corpora())
+    {
+        add_benchmark("parser/incremental/" + corpus.name + "/full", [&](state & st) {
+            st.run([&] {
+                auto mod = parse(corpus.source);
+                return corpus.source.size();
+            });
+        });
+
+        add_benchmark("parser/incremental/" + corpus.name + "/reparse", [&](state & st) {
+            auto at = static_cast<std::uint32_t>(corpus.source.find(U'\n', corpus.source.size() / 2) + 1);
+            lexer::text_edit insert{ at, at, U" " };
+            lexer::text_edit remove{ at, at + 1, U"" };
+
+            auto edited = corpus.source;
+            lexer::apply_edit(edited, insert);
+
+            auto mod = parse(corpus.source);
+            bool inserted = false;
+
+            st.run([&] {
+                mod = parser::reparse(mod, inserted ? corpus.source : edited, inserted ? remove : insert);
+                inserted = !inserted;
+                return corpus.source.size();
+            });
+        });
+    }
+    return true;
+}();
+}
@@ -0,0 +1,74 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <string>
+#include <thread>
+
+#include <reaver/future.h>
+
+#include "../generator.h"
+#include "../helpers.h"
+#include "vapor/parser.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+const synthetic_corpus & corpus()
+{
+    return synthetic_corpora().front();
+}
+
+void parse(state & st, parser::module_parsing parsing)
+{
+    // the tokens are lexed up front, like in parser/corpus/*, so that the numbers cover the parser alone
+    lexer::iterator head{ corpus().source.begin(), corpus().source.end(), lexer::engine::synchronous, lexer::handoff_mode::chunked };
+    std::size_t tokens = 0;
+    for (auto it = head; it; ++it)
+    {
+        ++tokens;
+    }
+
+    st.run([&] {
+        parser::ast ast{ head, {}, parser::node_allocation::arena, parsing };
+        return tokens;
+    });
+}
+
+auto serial = add_benchmark("parser/parallel/serial", [](state & st) { parse(st, parser::module_parsing::sequential); });
+
+// the thread running the benchmark parses too, so the pool gets one thread less than the count in the name
+auto registered = [] {
+    for (std::size_t threads = 2; threads <= std::max(std::thread::hardware_concurrency(), 2u); threads *= 2)
+    {
+        add_benchmark("parser/parallel/threads-" + std::to_string(threads), [threads](state & st) {
+            auto original = reaver::default_executor();
+            reaver::default_executor(reaver::make_executor<reaver::thread_pool>(threads - 1));
+
+            parse(st, parser::module_parsing::parallel);
+
+            reaver::default_executor(original);
+        });
+    }
+    return 0;
+}();
+}
@@ -0,0 +1,56 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <string>
+
+#include "../generator.h"
+#include "../helpers.h"
+#include "vapor/parser.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::benchmark;
+
+namespace
+{
+// compares loading a module from its serialized form with lexing and parsing it from scratch; items are characters of the source
+auto corpora = [] {
+    for (auto && corpus : synthetic_corpora())
+    {
+        add_benchmark("parser/serialization/" + corpus.name + "/parse", [&](state & st) {
+            st.run([&] {
+                parser::ast ast{ corpus.source, lexer::engine::synchronous };
+                return corpus.source.size();
+            });
+        });
+
+        add_benchmark("parser/serialization/" + corpus.name + "/load", [&](state & st) {
+            auto data = parser::serialize(parser::ast{ corpus.source, lexer::engine::synchronous });
+
+            st.run([&] {
+                auto ast = parser::deserialize(data);
+                return corpus.source.size();
+            });
+            st.report("serialized bytes/character", static_cast<double>(data.size()) / corpus.source.size());
+        });
+    }
+    return true;
+}();
+}
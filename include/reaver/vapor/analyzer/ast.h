@@ -79,11 +79,11 @@ inline namespace _v1
             return _modules.end();
         }
 
-        void simplify()
+        void simplify(simplification_reruns reruns = simplification_reruns::affected)
         {
             for (auto && module : _modules)
             {
-                module->simplify();
+                module->simplify(reruns);
             }
         }
 
@@ -104,7 +104,7 @@ inline namespace _v1
         virtual future<expression *> _simplify_expr(recursive_context ctx) override
         {
             return _owned->simplify_expr(ctx).then([&, this, ctx](auto && simplified) -> future<expression *> {
-                replace_uptr(_owned, simplified, ctx.proper);
+                replace_uptr(_owned, simplified, ctx);
                 return this->conversion_expression::_simplify_expr(ctx).then([&](auto && simpl) -> expression * {
                     if (simpl && simpl != this)
                     {
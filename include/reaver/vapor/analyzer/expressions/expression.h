@@ -77,7 +77,14 @@ inline namespace _v1
     public:
         future<expression *> simplify_expr(recursive_context ctx)
         {
-            return ctx.proper.get_future_or_init(this, [&]() { return make_ready_future().then([this, ctx]() { return _simplify_expr(ctx); }); });
+            ctx.used(this);
+            return ctx.proper.get_future_or_init(this, [&]() {
+                return run_simplification([this, ctx]() {
+                    auto own_ctx = ctx;
+                    own_ctx.user = this;
+                    return traced(trace_event{ "simplify", typeid(*this), _trace_range() }, [&] { return _simplify_expr(own_ctx); });
+                });
+            });
         }
 
         void set_context(expression_context ctx)
@@ -174,7 +181,7 @@ inline namespace _v1
             return false;
         }
 
-        virtual expression * get_member(const std::u32string & name) const
+        virtual expression * get_member(identifier_id name) const
         {
             auto repl = _get_replacement();
             if (repl == this)
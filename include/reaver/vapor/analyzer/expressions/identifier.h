@@ -37,12 +37,12 @@ inline namespace _v1
     class identifier : public expression_ref
     {
     public:
-        identifier(std::u32string name, scope * lex_scope, ast_node parse_info) : _lex_scope{ lex_scope }, _name{ std::move(name) }
+        identifier(identifier_id name, scope * lex_scope, ast_node parse_info) : _lex_scope{ lex_scope }, _name{ name }
         {
             _set_ast_info(parse_info);
         }
 
-        const std::u32string & name() const
+        identifier_id name() const
         {
             return _name;
         }
@@ -53,12 +53,12 @@ inline namespace _v1
         virtual future<> _analyze(analysis_context &) override;
 
         scope * _lex_scope;
-        std::u32string _name;
+        identifier_id _name;
     };
 
     inline std::unique_ptr<identifier> preanalyze_identifier(const parser::identifier & parse, scope * lex_scope)
     {
-        return std::make_unique<identifier>(parse.value.string, lex_scope, make_node(parse));
+        return std::make_unique<identifier>(parse.value.id, lex_scope, make_node(parse));
     }
 }
 }
@@ -33,13 +33,13 @@ inline namespace _v1
     class member_expression : public expression
     {
     public:
-        member_expression(type * parent_type, std::u32string name, type * own_type) : expression{ own_type }, _parent{ parent_type }, _name{ std::move(name) }
+        member_expression(type * parent_type, identifier_id name, type * own_type) : expression{ own_type }, _parent{ parent_type }, _name{ name }
         {
         }
 
         codegen::ir::member_variable member_codegen_ir(ir_generation_context & ctx) const;
 
-        const std::u32string & get_name() const
+        identifier_id get_name() const
         {
             return _name;
         }
@@ -48,7 +48,7 @@ inline namespace _v1
         {
             os << styles::def << ctx << styles::rule_name << "member-expression";
             os << styles::def << " @ " << styles::address << this << styles::def << ": ";
-            os << styles::string_value << utf8(_name) << styles::def << '\n';
+            os << styles::string_value << utf8(_name.string()) << styles::def << '\n';
 
             auto type_ctx = ctx.make_branch(false);
             os << styles::def << type_ctx << styles::subrule_name << "type:\n";
@@ -95,12 +95,12 @@ inline namespace _v1
         }
 
         type * _parent = nullptr;
-        std::u32string _name;
+        identifier_id _name;
     };
 
-    inline auto make_member_expression(type * parent, std::u32string name, type * own_type)
+    inline auto make_member_expression(type * parent, identifier_id name, type * own_type)
     {
-        return std::make_unique<member_expression>(parent, std::move(name), own_type);
+        return std::make_unique<member_expression>(parent, name, own_type);
     }
 }
 }
@@ -33,12 +33,12 @@ inline namespace _v1
     class member_access_expression : public expression
     {
     public:
-        member_access_expression(ast_node parse, std::u32string name) : _name{ std::move(name) }
+        member_access_expression(ast_node parse, identifier_id name) : _name{ name }
         {
             _set_ast_info(parse);
         }
 
-        member_access_expression(std::u32string name, type * referenced_type) : expression{ referenced_type }, _name{ std::move(name) }
+        member_access_expression(identifier_id name, type * referenced_type) : expression{ referenced_type }, _name{ name }
         {
             assert(referenced_type);
         }
@@ -109,7 +109,7 @@ inline namespace _v1
         virtual statement_ir _codegen_ir(ir_generation_context &) const override;
         virtual bool _invalidate_ir(ir_generation_context &) const override;
 
-        std::u32string _name;
+        identifier_id _name;
 
         expression * _referenced = nullptr;
         mutable const expression * _base = nullptr;
@@ -133,9 +133,9 @@ inline namespace _v1
 {
     std::unique_ptr<member_access_expression> preanalyze_member_access_expression(const parser::member_expression & parse, scope *);
 
-    inline std::unique_ptr<member_access_expression> make_member_access_expression(std::u32string name, type * ref_type)
+    inline std::unique_ptr<member_access_expression> make_member_access_expression(identifier_id name, type * ref_type)
     {
-        return std::make_unique<member_access_expression>(std::move(name), ref_type);
+        return std::make_unique<member_access_expression>(name, ref_type);
     }
 }
 }
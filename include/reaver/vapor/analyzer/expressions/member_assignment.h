@@ -32,12 +32,12 @@ inline namespace _v1
     class member_assignment_expression : public expression
     {
     public:
-        member_assignment_expression(std::u32string member_name) : _type{ make_member_assignment_type(std::move(member_name), this) }
+        member_assignment_expression(identifier_id member_name) : _type{ make_member_assignment_type(member_name, this) }
         {
             _set_type(_type.get());
         }
 
-        const std::u32string member_name() const
+        identifier_id member_name() const
         {
             return _type->member_name();
         }
@@ -113,9 +113,9 @@ inline namespace _v1
         std::unique_ptr<member_assignment_type> _type;
     };
 
-    inline auto make_member_assignment_expression(std::u32string member_name)
+    inline auto make_member_assignment_expression(identifier_id member_name)
     {
-        return std::make_unique<member_assignment_expression>(std::move(member_name));
+        return std::make_unique<member_assignment_expression>(member_name);
     }
 }
 }
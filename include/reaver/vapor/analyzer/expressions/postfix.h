@@ -38,7 +38,7 @@ inline namespace _v1
             std::unique_ptr<expression> base,
             optional<lexer::token_type> mod,
             std::vector<std::unique_ptr<expression>> arguments,
-            optional<std::u32string> accessed_member);
+            optional<identifier_id> accessed_member);
 
         virtual void print(std::ostream & os, print_context ctx) const override;
 
@@ -104,7 +104,7 @@ inline namespace _v1
         std::vector<std::unique_ptr<expression>> _arguments;
         std::unique_ptr<expression> _call_expression;
 
-        optional<std::u32string> _accessed_member;
+        optional<identifier_id> _accessed_member;
         optional<expression *> _referenced_expression;
     };
 }
@@ -27,6 +27,7 @@
 #include <boost/multiprecision/integer.hpp>
 
 #include "../types/sized_integer.h"
+#include "../types/sized_integer_value.h"
 #include "expression.h"
 
 namespace reaver::vapor::analyzer
@@ -36,13 +37,13 @@ inline namespace _v1
     class sized_integer_constant : public expression
     {
     public:
-        sized_integer_constant(sized_integer * type, boost::multiprecision::cpp_int value) : expression{ type }, _value{ std::move(value) }, _type{ type }
+        sized_integer_constant(sized_integer * type, sized_integer_value value) : expression{ type }, _value{ std::move(value) }, _type{ type }
         {
             assert(_value <= _type->max_value());
             assert(_value >= _type->min_value());
         }
 
-        auto get_value() const
+        const auto & get_value() const
         {
             return _value;
         }
@@ -87,7 +88,7 @@ inline namespace _v1
             return other->get_value() == _value;
         }
 
-        boost::multiprecision::cpp_int _value;
+        sized_integer_value _value;
         sized_integer * _type;
     };
 }
@@ -52,7 +52,7 @@ inline namespace _v1
             return std::all_of(_fields_in_order.begin(), _fields_in_order.end(), [](auto && field) { return field->is_constant(); });
         }
 
-        virtual expression * get_member(const std::u32string & name) const override
+        virtual expression * get_member(identifier_id name) const override
         {
             auto it = std::find_if(_fields.begin(), _fields.end(), [&](auto && elem) { return elem.first->get_name() == name; });
             if (it == _fields.end())
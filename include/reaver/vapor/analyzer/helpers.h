@@ -51,15 +51,31 @@ inline namespace _v1
         error(std::move(message), parse, default_error_engine());
     }
 
-    template<typename T, typename U>
-    auto replace_uptr(std::unique_ptr<T> & uptr, U * ptr, simplification_context & ctx) -> decltype(uptr.reset(ptr), void())
+    namespace _detail
     {
-        if (ptr && uptr.get() != ptr)
+        // returns the node that was replaced, if any; it's up to the caller to say that something happened
+        template<typename T, typename U>
+        auto replace_uptr(std::unique_ptr<T> & uptr, U * ptr, simplification_context & ctx) -> decltype(uptr.reset(ptr), static_cast<T *>(nullptr))
         {
+            if (!ptr || uptr.get() == ptr)
+            {
+                return nullptr;
+            }
+
             logger::dlog(logger::trace) << "Replacing " << uptr.get() << " with " << ptr;
             logger::default_logger().sync();
-            ctx.keep_alive(uptr.release());
+            auto replaced = uptr.release();
+            ctx.keep_alive(replaced);
             uptr.reset(ptr);
+            return replaced;
+        }
+    }
+
+    template<typename T, typename U>
+    auto replace_uptr(std::unique_ptr<T> & uptr, U * ptr, simplification_context & ctx) -> decltype(uptr.reset(ptr), void())
+    {
+        if (_detail::replace_uptr(uptr, ptr, ctx))
+        {
             ctx.something_happened();
         }
     }
@@ -75,5 +91,28 @@ inline namespace _v1
             replace_uptr(*it, *it_ptrs, ctx);
         }
     }
+
+    // like the ones above, but also records the replacement as made in the node that `ctx` simplifies, and the replaced node
+    // as changed for everything that used it
+    template<typename T, typename U>
+    auto replace_uptr(std::unique_ptr<T> & uptr, U * ptr, const recursive_context & ctx) -> decltype(uptr.reset(ptr), void())
+    {
+        if (auto replaced = _detail::replace_uptr(uptr, ptr, ctx.proper))
+        {
+            ctx.something_happened(replaced);
+        }
+    }
+
+    template<typename T, typename U>
+    void replace_uptrs(std::vector<std::unique_ptr<T>> & uptrs, const std::vector<U *> & ptrs, const recursive_context & ctx)
+    {
+        assert(uptrs.size() == ptrs.size());
+
+        auto it_ptrs = ptrs.begin();
+        for (auto it = uptrs.begin(), end = uptrs.end(); it != end; ++it, ++it_ptrs)
+        {
+            replace_uptr(*it, *it_ptrs, ctx);
+        }
+    }
 }
 }
@@ -45,17 +45,26 @@ namespace reaver::vapor::analyzer
 {
 inline namespace _v1
 {
+    // which statements of a module are simplified again after a run that replaced something
+    enum class simplification_reruns
+    {
+        // only the ones that the replacements can have affected
+        affected,
+        // all of them, until nothing changes anymore; what the first one is tested against
+        all
+    };
+
     class module
     {
     public:
         module(const parser::module & parse);
 
         void analyze(analysis_context &);
-        void simplify();
+        void simplify(simplification_reruns reruns = simplification_reruns::affected);
 
         std::u32string name() const
         {
-            return boost::join(fmap(_parse.name.id_expression_value, [](auto && elem) -> decltype(auto) { return elem.value.string; }), ".");
+            return boost::join(fmap(_parse.name.id_expression_value, [](auto && elem) { return elem.value.string.str(); }), ".");
         }
 
         void print(std::ostream & os, print_context ctx) const;
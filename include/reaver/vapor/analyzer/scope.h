@@ -31,6 +31,7 @@
 #include <reaver/optional.h>
 
 #include "../codegen/ir/scope.h"
+#include "../lexer/interner.h"
 #include "../utf.h"
 #include "ir_context.h"
 
@@ -38,10 +39,13 @@ namespace reaver::vapor::analyzer
 {
 inline namespace _v1
 {
+    // names of symbols and members are interned, and looked up by their IDs
+    using lexer::identifier_id;
+
     class failed_lookup : public exception
     {
     public:
-        failed_lookup(const std::u32string & n) : exception{ logger::error }, name{ n }
+        failed_lookup(identifier_id n) : exception{ logger::error }, name{ n.str() }
         {
             *this << "failed scope lookup for `" << utf8(name) << "`.";
         }
@@ -51,7 +55,7 @@ inline namespace _v1
 
     class symbol;
 
-    const std::unordered_map<std::u32string, std::unique_ptr<symbol>> & non_overridable();
+    const std::unordered_map<identifier_id, std::unique_ptr<symbol>> & non_overridable();
 
     class scope
     {
@@ -112,23 +116,23 @@ inline namespace _v1
             return std::make_unique<scope>(_key{}, this, false, true);
         }
 
-        auto get(const std::u32string & name) const
+        auto get(identifier_id name) const
         {
             _shlock lock{ _lock };
             return _symbols.at(name).get();
         }
 
-        auto try_get(const std::u32string & name) const
+        auto try_get(identifier_id name) const
         {
             _shlock lock{ _lock };
             auto it = _symbols.find(name);
             return it != _symbols.end() ? make_optional(it->second.get()) : none;
         }
 
-        bool init(const std::u32string & name, std::unique_ptr<symbol> symb);
+        bool init(identifier_id name, std::unique_ptr<symbol> symb);
 
         template<typename F>
-        auto get_or_init(const std::u32string & name, F init)
+        auto get_or_init(identifier_id name, F init)
         {
             if (non_overridable().find(name) != non_overridable().end())
             {
@@ -166,8 +170,8 @@ inline namespace _v1
         // this will always give you a thingy from *current* scope
         // if you want to get from any of the scopes up
         // do use resolve()
-        future<symbol *> get_future(const std::u32string & name) const;
-        future<symbol *> resolve(const std::u32string & name) const;
+        future<symbol *> get_future(identifier_id name) const;
+        future<symbol *> resolve(identifier_id name) const;
 
         const auto & declared_symbols() const
         {
@@ -218,11 +222,12 @@ inline namespace _v1
 
         scope * _parent = nullptr;
         std::unordered_set<std::unique_ptr<scope>> _keepalive;
-        std::unordered_map<std::u32string, std::unique_ptr<symbol>> _symbols;
+        // keyed on the IDs, so that lookups only hash and compare integers
+        std::unordered_map<identifier_id, std::unique_ptr<symbol>> _symbols;
         std::vector<symbol *> _symbols_in_order;
-        mutable std::unordered_map<std::u32string, future<symbol *>> _symbol_futures;
-        mutable std::unordered_map<std::u32string, manual_promise<symbol *>> _symbol_promises;
-        mutable std::unordered_map<std::u32string, future<symbol *>> _resolve_futures;
+        mutable std::unordered_map<identifier_id, future<symbol *>> _symbol_futures;
+        mutable std::unordered_map<identifier_id, manual_promise<symbol *>> _symbol_promises;
+        mutable std::unordered_map<identifier_id, future<symbol *>> _resolve_futures;
         const bool _is_local_scope = false;
         const bool _is_shadowing_boundary = false;
         bool _is_closed = false;
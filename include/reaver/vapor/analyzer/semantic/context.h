@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "../simplification/context.h"
 
 namespace reaver::vapor::analyzer
@@ -37,11 +39,18 @@ inline namespace _v1
         {
         }
 
+        // the sized integer type of a given width; the first call for a width creates it, and the ones after that return the
+        // same type, even when they race with it
+        type * get_sized_integer_type(std::size_t size);
+
         std::shared_ptr<cached_results> results;
         std::shared_ptr<simplification_context> simplification_ctx;
-        std::unordered_map<std::size_t, std::shared_ptr<type>> sized_integers;
         bool entry_point_marked = false;
         bool entry_variable_marked = false;
+
+    private:
+        std::mutex _sized_integers_lock;
+        std::unordered_map<std::size_t, std::shared_ptr<type>> _sized_integers;
     };
 }
 }
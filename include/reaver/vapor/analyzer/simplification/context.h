@@ -22,12 +22,17 @@
 
 #pragma once
 
+#include <cstddef>
+#include <exception>
 #include <shared_mutex>
 #include <unordered_map>
 
 #include <reaver/future.h>
+#include <reaver/optional.h>
 
+#include "dependencies.h"
 #include "replacements.h"
+#include "sharded_map.h"
 
 namespace reaver::vapor::analyzer
 {
@@ -67,6 +72,7 @@ inline namespace _v1
         std::unique_ptr<expression> get_call_result(call_frame) const;
 
     private:
+        mutable std::shared_mutex _lock;
         std::unordered_map<call_frame, std::unique_ptr<expression>> _cached_call_results;
         std::vector<std::unique_ptr<expression>> _key_store;
     };
@@ -85,31 +91,59 @@ inline namespace _v1
         {
             auto && futs = _get_futures<T>();
 
+            if (auto existing = futs.find(ptr))
             {
-                _shlock lock{ _futures_lock };
-                auto it = futs.find(ptr);
-                if (it != futs.end())
-                {
-                    return it->second;
-                }
+                return std::move(*existing);
             }
 
-            _ulock lock{ _futures_lock };
-            auto it = futs.find(ptr);
-            if (it != futs.end())
+            auto pair = make_promise<T *>();
+
+            auto inserted = futs.insert(ptr, pair.future);
+            if (!inserted.second)
             {
-                return it->second;
+                return std::move(inserted.first);
             }
 
-            auto fut = std::forward<F>(f)();
-            futs.emplace(ptr, fut);
+            // `f` can simplify the node right away, and with it the nodes below it, so it's called after the entry is inserted;
+            // the others that ask for this node in the meantime get the future of the promise
+            optional<future<T *>> result;
+            try
+            {
+                result = std::forward<F>(f)();
+
+                if (auto value = result->try_get())
+                {
+                    pair.promise.set(*value);
+                }
 
-            _handle_expressions(ptr, fut);
+                else
+                {
+                    result->then([promise = pair.promise](auto && value) { promise.set(value); })
+                        .on_error([promise = pair.promise](std::exception_ptr ex) { promise.set(ex); })
+                        .detach();
+                }
+            }
+
+            catch (...)
+            {
+                pair.promise.set(std::current_exception());
+                if (!result)
+                {
+                    throw;
+                }
+            }
 
-            return fut;
+            return std::move(*result);
         }
 
         void something_happened()
+        {
+            _something_happened = true;
+            _something_untracked_happened = true;
+        }
+
+        // something happened in a node that was marked dirty in a dependency graph, so the graph knows what it affects
+        void something_tracked_happened()
         {
             _something_happened = true;
         }
@@ -119,33 +153,28 @@ inline namespace _v1
             return _something_happened;
         }
 
+        // whether something happened that no dependency graph knows about
+        bool did_something_untracked_happen() const
+        {
+            return _something_untracked_happened;
+        }
+
         void keep_alive(statement * ptr);
 
         cached_results & results;
 
     private:
         std::atomic<bool> _something_happened{ false };
+        std::atomic<bool> _something_untracked_happened{ false };
 
-        using _ulock = std::unique_lock<std::shared_mutex>;
-        using _shlock = std::shared_lock<std::shared_mutex>;
-
-        mutable std::shared_mutex _futures_lock;
-        std::unordered_map<statement *, future<statement *>> _statement_futures;
-        std::unordered_map<expression *, future<expression *>> _expression_futures;
+        sharded_node_map<statement, future<statement *>> _statement_futures;
+        sharded_node_map<expression, future<expression *>> _expression_futures;
 
         std::mutex _keep_alive_lock;
         std::unordered_set<std::unique_ptr<statement>> _keep_alive_stmt;
 
         template<typename T>
         auto & _get_futures() = delete;
-
-        template<typename T, typename Future>
-        void _handle_expressions(T *, Future &&)
-        {
-        }
-
-        // sorry for this, but need a definition of expression for this one thing...
-        void _handle_expressions(expression * ptr, future<expression *> & fut);
     };
 
     template<>
@@ -160,12 +189,81 @@ inline namespace _v1
         return _expression_futures;
     }
 
+    namespace _detail
+    {
+        inline std::size_t & inline_simplification_depth()
+        {
+            thread_local std::size_t depth = 0;
+            return depth;
+        }
+    }
+
+    // how many simplifications can run inline, nested in each other, on a single thread; the next one is scheduled on the
+    // executor, so that the stack stays bounded, and so that the other threads can steal parts of a deep tree
+    constexpr std::size_t max_inline_simplification_depth = 16;
+
+    // runs `f`, which starts the simplification of a node, right away when the chain of simplifications it's nested in is
+    // short, instead of paying for a task on the executor for every node
+    template<typename F>
+    auto run_simplification(F f)
+    {
+        auto & depth = _detail::inline_simplification_depth();
+        if (depth >= max_inline_simplification_depth)
+        {
+            return make_ready_future().then(std::move(f));
+        }
+
+        struct guard
+        {
+            std::size_t & depth;
+
+            ~guard()
+            {
+                --depth;
+            }
+        } nested{ ++depth };
+
+        return f();
+    }
+
     struct recursive_context
     {
         simplification_context & proper;
 
         // this desperately needs a functional data structure
         std::vector<call_frame> call_stack = {};
+
+        // where the uses of nodes, and the replacements in them, are recorded; there's none while folding calls, since
+        // those simplify clones that don't outlive the call
+        dependency_graph * dependencies = nullptr;
+        // the node that is being simplified, and so the user of the nodes simplified with this context
+        const statement * user = nullptr;
+
+        void used(const statement * node) const
+        {
+            if (dependencies && user && user != node)
+            {
+                dependencies->add_use(node, user);
+            }
+        }
+
+        // `replaced` is the node that was replaced, if anything was; whatever used it, not only `user`, has to be simplified
+        // again
+        void something_happened(const statement * replaced = nullptr) const
+        {
+            if (dependencies && user)
+            {
+                dependencies->mark_dirty(user);
+                if (replaced)
+                {
+                    dependencies->mark_dirty(replaced);
+                }
+                proper.something_tracked_happened();
+                return;
+            }
+
+            proper.something_happened();
+        }
     };
 }
 }
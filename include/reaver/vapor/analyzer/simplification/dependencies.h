@@ -0,0 +1,63 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "sharded_map.h"
+
+namespace reaver::vapor::analyzer
+{
+inline namespace _v1
+{
+    class statement;
+
+    // which nodes used which other nodes while they were being simplified, and in which of them something was replaced
+    // since the last time it was asked about; it lets a module simplify again only the statements that a replacement can
+    // have affected, instead of all of them
+    // the nodes that are gone are never removed, so a node that's allocated in the place of one of them inherits its users;
+    // that only ever causes a statement to be simplified again for no reason
+    class dependency_graph
+    {
+    public:
+        // `user` simplified `used`, or looked up the result of simplifying it
+        void add_use(const statement * used, const statement * user);
+
+        // something was replaced while `node` was being simplified, or `node` itself was replaced
+        void mark_dirty(const statement * node);
+
+        // the indices of the roots that use, directly or not, any of the nodes marked dirty since the last call; `roots`
+        // maps the roots to their indices
+        std::vector<std::size_t> take_affected(const std::unordered_map<const statement *, std::size_t> & roots);
+
+    private:
+        sharded_node_map<const statement, std::unordered_set<const statement *>> _users;
+
+        std::mutex _dirty_lock;
+        std::unordered_set<const statement *> _dirty;
+    };
+}
+}
@@ -0,0 +1,110 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <reaver/optional.h>
+
+namespace reaver::vapor::analyzer
+{
+inline namespace _v1
+{
+    // a map from node pointers to values, split into shards that each have their own lock, so that the threads looking up
+    // different nodes rarely wait for each other
+    template<typename T, typename Value, std::size_t Shards = 32>
+    class sharded_node_map
+    {
+    public:
+        optional<Value> find(T * ptr) const
+        {
+            auto & shard = _shard(ptr);
+            std::shared_lock<std::shared_mutex> lock{ shard.lock };
+
+            auto it = shard.values.find(ptr);
+            if (it != shard.values.end())
+            {
+                return it->second;
+            }
+
+            return none;
+        }
+
+        // inserts `value`, unless there already is a value for `ptr`; returns the value that is in the map after that, and
+        // whether it is the one that was passed in
+        std::pair<Value, bool> insert(T * ptr, Value value)
+        {
+            auto & shard = _shard(ptr);
+            std::unique_lock<std::shared_mutex> lock{ shard.lock };
+
+            auto inserted = shard.values.emplace(ptr, std::move(value));
+            return { inserted.first->second, inserted.second };
+        }
+
+        // calls `f` with a reference to the value for `ptr`, default constructing it first if there is none, while no one else
+        // can access it
+        template<typename F>
+        void update(T * ptr, F && f)
+        {
+            auto & shard = _shard(ptr);
+            std::unique_lock<std::shared_mutex> lock{ shard.lock };
+
+            std::forward<F>(f)(shard.values[ptr]);
+        }
+
+    private:
+        // a shard per cache line, so that taking the lock of one doesn't invalidate the others
+        struct alignas(64) _shard_t
+        {
+            mutable std::shared_mutex lock;
+            std::unordered_map<T *, Value> values;
+        };
+
+        _shard_t & _shard(T * ptr)
+        {
+            return _shards[_shard_index(ptr)];
+        }
+
+        const _shard_t & _shard(T * ptr) const
+        {
+            return _shards[_shard_index(ptr)];
+        }
+
+        static std::size_t _shard_index(T * ptr)
+        {
+            // the low bits of a pointer are the same for all the nodes, because of alignment, and the high ones change
+            // rarely, so the ones in between are mixed before being used
+            auto bits = reinterpret_cast<std::uintptr_t>(ptr) >> 4;
+            return (bits * 0x9e3779b97f4a7c15ull >> 32) % Shards;
+        }
+
+        std::array<_shard_t, Shards> _shards;
+    };
+}
+}
@@ -77,7 +77,7 @@ inline namespace _v1
         virtual future<statement *> _simplify(recursive_context ctx) override
         {
             return _value_expr->simplify_expr(ctx).then([&, ctx](auto && simplified) -> statement * {
-                replace_uptr(_value_expr, simplified, ctx.proper);
+                replace_uptr(_value_expr, simplified, ctx);
                 return this;
             });
         }
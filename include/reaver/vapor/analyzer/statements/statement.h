@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <typeinfo>
+
 #include <reaver/future.h>
 
 #include "../../codegen/ir/function.h"
@@ -32,6 +34,7 @@
 #include "../semantic/context.h"
 #include "../simplification/context.h"
 #include "../simplification/replacements.h"
+#include "../trace.h"
 
 namespace reaver::vapor::parser
 {
@@ -64,7 +67,7 @@ inline namespace _v1
                 std::lock_guard<std::mutex> lock{ _future_lock };
                 if (!_is_future_assigned)
                 {
-                    _analysis_future = _analyze(ctx);
+                    _analysis_future = traced(trace_event{ "analyze", typeid(*this), _trace_range() }, [&] { return _analyze(ctx); });
                     _analysis_future
                         ->on_error([](std::exception_ptr ptr) {
                             try
@@ -108,7 +111,14 @@ inline namespace _v1
 
         future<statement *> simplify(recursive_context ctx)
         {
-            return ctx.proper.get_future_or_init(this, [&]() { return make_ready_future().then([this, ctx]() { return _simplify(ctx); }); });
+            ctx.used(this);
+            return ctx.proper.get_future_or_init(this, [&]() {
+                return run_simplification([this, ctx]() {
+                    auto own_ctx = ctx;
+                    own_ctx.user = this;
+                    return _simplify(own_ctx);
+                });
+            });
         }
 
         virtual std::vector<const return_statement *> get_returns() const
@@ -160,6 +170,16 @@ inline namespace _v1
             _parse_info = info;
         }
 
+        optional<range_type> _trace_range() const
+        {
+            if (_parse_info)
+            {
+                return _parse_info->range;
+            }
+
+            return none;
+        }
+
     private:
         virtual future<> _analyze(analysis_context &)
         {
@@ -37,7 +37,7 @@ inline namespace _v1
         using _shlock = std::shared_lock<std::shared_mutex>;
 
     public:
-        symbol(std::u32string name, expression * expression) : _name{ std::move(name) }, _expression{ expression }
+        symbol(identifier_id name, expression * expression) : _name{ name }, _expression{ expression }
         {
         }
 
@@ -70,6 +70,11 @@ inline namespace _v1
         }
 
         std::u32string get_name() const
+        {
+            return _name.str();
+        }
+
+        identifier_id get_id() const
         {
             return _name;
         }
@@ -106,16 +111,16 @@ inline namespace _v1
     private:
         mutable std::shared_mutex _lock;
 
-        std::u32string _name;
+        identifier_id _name;
 
         expression * _expression;
         optional<future<expression *>> _future;
         optional<manual_promise<expression *>> _promise;
     };
 
-    inline auto make_symbol(std::u32string name, expression * expression = nullptr)
+    inline auto make_symbol(identifier_id name, expression * expression = nullptr)
     {
-        return std::make_unique<symbol>(std::move(name), expression);
+        return std::make_unique<symbol>(name, expression);
     }
 }
 }
@@ -0,0 +1,88 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <utility>
+
+#include <reaver/future.h>
+
+#include "../trace.h"
+
+namespace reaver::vapor::analyzer
+{
+inline namespace _v1
+{
+    namespace _detail
+    {
+        // the event is finished whether the future succeeds or fails, so that every span in the trace is closed
+        inline future<> finish_when_ready(future<> fut, trace_event event)
+        {
+            auto pair = make_promise<void>();
+
+            auto finish = [event, promise = pair.promise] {
+                event.finish();
+                promise.set();
+            };
+            auto fail = [event, promise = pair.promise](std::exception_ptr ex) {
+                event.finish();
+                promise.set(ex);
+            };
+            fut.then(finish).on_error(fail).detach();
+
+            return std::move(pair.future);
+        }
+
+        template<typename T>
+        future<T> finish_when_ready(future<T> fut, trace_event event)
+        {
+            auto pair = make_promise<T>();
+
+            auto finish = [event, promise = pair.promise](T value) {
+                event.finish();
+                promise.set(std::move(value));
+            };
+            auto fail = [event, promise = pair.promise](std::exception_ptr ex) {
+                event.finish();
+                promise.set(ex);
+            };
+            fut.then(finish).on_error(fail).detach();
+
+            return std::move(pair.future);
+        }
+    }
+
+    // calls `f`, which starts some work and returns a future of its result, as the span of `event`, which ends once
+    // that future is ready
+    template<typename F>
+    auto traced(trace_event event, F && f)
+    {
+        auto fut = std::forward<F>(f)();
+        if (!event.active())
+        {
+            return fut;
+        }
+
+        return _detail::finish_when_ready(std::move(fut), event);
+    }
+}
+}
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <boost/algorithm/string/join.hpp>
 #include <boost/functional/hash.hpp>
 
@@ -83,7 +85,9 @@ inline namespace _v1
     {
         using map_type = std::unordered_map<function_type_elements, std::unique_ptr<function_type>, function_type_elements_hash>;
         static map_type map;
+        static std::mutex map_lock;
 
+        std::lock_guard<std::mutex> lock{ map_lock };
         auto & ret = map[std::make_pair(return_type, parameter_types)];
         if (!ret)
         {
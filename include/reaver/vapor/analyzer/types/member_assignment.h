@@ -32,13 +32,13 @@ inline namespace _v1
     class member_assignment_expression;
     class member_assignment_type;
 
-    std::unique_ptr<member_assignment_type> make_member_assignment_type(std::u32string member_name, member_assignment_expression * var, bool = false);
+    std::unique_ptr<member_assignment_type> make_member_assignment_type(identifier_id member_name, member_assignment_expression * var, bool = false);
 
     class member_assignment_type : public type
     {
     public:
-        member_assignment_type(std::u32string member_name, member_assignment_expression * expr, bool is_assigned = false)
-            : _member_name{ std::move(member_name) }, _expr{ expr }, _assigned{ is_assigned }
+        member_assignment_type(identifier_id member_name, member_assignment_expression * expr, bool is_assigned = false)
+            : _member_name{ member_name }, _expr{ expr }, _assigned{ is_assigned }
         {
             if (!_assigned)
             {
@@ -50,17 +50,17 @@ inline namespace _v1
 
         virtual std::string explain() const override
         {
-            return "member assignment type for member " + utf8(_member_name);
+            return "member assignment type for member " + utf8(_member_name.string());
         }
 
         virtual void print(std::ostream & os, print_context ctx) const override
         {
             os << styles::def << ctx << styles::type << "member assignment type";
             os << styles::def << " @ " << styles::address << this;
-            os << styles::def << ": " << styles::string_value << utf8(_member_name) << '\n';
+            os << styles::def << ": " << styles::string_value << utf8(_member_name.string()) << '\n';
         }
 
-        const std::u32string & member_name() const
+        identifier_id member_name() const
         {
             return _member_name;
         }
@@ -83,7 +83,7 @@ inline namespace _v1
             assert(0);
         }
 
-        std::u32string _member_name;
+        identifier_id _member_name;
         member_assignment_expression * _expr;
 
         bool _assigned = false;
@@ -94,9 +94,9 @@ inline namespace _v1
         mutable std::vector<std::unique_ptr<expression>> _expr_storage;
     };
 
-    inline std::unique_ptr<member_assignment_type> make_member_assignment_type(std::u32string member_name, member_assignment_expression * var, bool is_assigned)
+    inline std::unique_ptr<member_assignment_type> make_member_assignment_type(identifier_id member_name, member_assignment_expression * var, bool is_assigned)
     {
-        return std::make_unique<member_assignment_type>(std::move(member_name), var, is_assigned);
+        return std::make_unique<member_assignment_type>(member_name, var, is_assigned);
     }
 }
 }
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../function.h"
+#include "sized_integer_value.h"
 #include "type.h"
 
 namespace reaver::vapor::analyzer
@@ -89,12 +90,12 @@ inline namespace _v1
             return this != other;
         }
 
-        auto max_value() const
+        const auto & max_value() const
         {
             return _max_value;
         }
 
-        auto min_value() const
+        const auto & min_value() const
         {
             return _min_value;
         }
@@ -113,8 +114,8 @@ inline namespace _v1
         }
 
         std::size_t _size;
-        boost::multiprecision::cpp_int _max_value;
-        boost::multiprecision::cpp_int _min_value;
+        sized_integer_value _max_value;
+        sized_integer_value _min_value;
 
         template<typename Instruction, typename Eval>
         auto _generate_function(std::u32string name, std::string desc, Eval eval, type * return_type);
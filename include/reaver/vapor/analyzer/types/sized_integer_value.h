@@ -0,0 +1,172 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+#include <boost/functional/hash.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+
+namespace reaver::vapor::analyzer
+{
+inline namespace _v1
+{
+    // a value of a sized integer; values that fit in 64 bits are kept inline and folded with overflow-checked builtins,
+    // and only the ones that don't (from types wider than that, or ones that overflowed) are kept as a big integer
+    // a value is always kept inline when it fits, so two equal values always have the same representation
+    class sized_integer_value
+    {
+    public:
+        sized_integer_value(std::int64_t value) : _small{ value }, _is_small{ true }
+        {
+        }
+
+        sized_integer_value(boost::multiprecision::cpp_int value)
+        {
+            if (value >= std::numeric_limits<std::int64_t>::min() && value <= std::numeric_limits<std::int64_t>::max())
+            {
+                _small = value.convert_to<std::int64_t>();
+                _is_small = true;
+                return;
+            }
+
+            _big = std::move(value);
+        }
+
+        bool is_small() const
+        {
+            return _is_small;
+        }
+
+        boost::multiprecision::cpp_int to_cpp_int() const
+        {
+            if (_is_small)
+            {
+                return _small;
+            }
+
+            return _big;
+        }
+
+        friend sized_integer_value operator+(const sized_integer_value & lhs, const sized_integer_value & rhs)
+        {
+            std::int64_t result;
+            if (lhs._is_small && rhs._is_small && !__builtin_add_overflow(lhs._small, rhs._small, &result))
+            {
+                return result;
+            }
+
+            return boost::multiprecision::cpp_int{ lhs.to_cpp_int() + rhs.to_cpp_int() };
+        }
+
+        friend sized_integer_value operator-(const sized_integer_value & lhs, const sized_integer_value & rhs)
+        {
+            std::int64_t result;
+            if (lhs._is_small && rhs._is_small && !__builtin_sub_overflow(lhs._small, rhs._small, &result))
+            {
+                return result;
+            }
+
+            return boost::multiprecision::cpp_int{ lhs.to_cpp_int() - rhs.to_cpp_int() };
+        }
+
+        friend sized_integer_value operator*(const sized_integer_value & lhs, const sized_integer_value & rhs)
+        {
+            std::int64_t result;
+            if (lhs._is_small && rhs._is_small && !__builtin_mul_overflow(lhs._small, rhs._small, &result))
+            {
+                return result;
+            }
+
+            return boost::multiprecision::cpp_int{ lhs.to_cpp_int() * rhs.to_cpp_int() };
+        }
+
+        friend bool operator==(const sized_integer_value & lhs, const sized_integer_value & rhs)
+        {
+            if (lhs._is_small != rhs._is_small)
+            {
+                return false;
+            }
+
+            return lhs._is_small ? lhs._small == rhs._small : lhs._big == rhs._big;
+        }
+
+        friend bool operator!=(const sized_integer_value & lhs, const sized_integer_value & rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const sized_integer_value & lhs, const sized_integer_value & rhs)
+        {
+            if (lhs._is_small && rhs._is_small)
+            {
+                return lhs._small < rhs._small;
+            }
+
+            return lhs.to_cpp_int() < rhs.to_cpp_int();
+        }
+
+        friend bool operator<=(const sized_integer_value & lhs, const sized_integer_value & rhs)
+        {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>(const sized_integer_value & lhs, const sized_integer_value & rhs)
+        {
+            return rhs < lhs;
+        }
+
+        friend bool operator>=(const sized_integer_value & lhs, const sized_integer_value & rhs)
+        {
+            return !(lhs < rhs);
+        }
+
+        friend std::ostream & operator<<(std::ostream & os, const sized_integer_value & value)
+        {
+            if (value._is_small)
+            {
+                return os << value._small;
+            }
+
+            return os << value._big;
+        }
+
+        friend std::size_t hash_value(const sized_integer_value & value)
+        {
+            if (value._is_small)
+            {
+                return boost::hash_value(value._small);
+            }
+
+            return boost::hash<boost::multiprecision::cpp_int>{}(value._big);
+        }
+
+    private:
+        std::int64_t _small = 0;
+        boost::multiprecision::cpp_int _big;
+        bool _is_small = false;
+    };
+}
+}
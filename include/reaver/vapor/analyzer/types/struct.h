@@ -79,7 +79,7 @@ inline namespace _v1
             return make_optional(_parse);
         }
 
-        virtual type * get_member_type(const std::u32string & name) const override
+        virtual type * get_member_type(identifier_id name) const override
         {
             auto it = std::find_if(_data_members.begin(), _data_members.end(), [&](auto && member) { return member->get_name() == name; });
             if (it == _data_members.end())
@@ -130,7 +130,7 @@ inline namespace _v1
             return _member_scope.get();
         }
 
-        virtual type * get_member_type(const std::u32string &) const
+        virtual type * get_member_type(identifier_id) const
         {
             return nullptr;
         }
@@ -23,7 +23,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <reaver/variant.h>
@@ -81,7 +83,9 @@ inline namespace _v1
                 std::shared_ptr<variable_type> sized_integer(std::size_t size) const
                 {
                     static std::unordered_map<std::size_t, std::shared_ptr<variable_type>> types;
+                    static std::mutex types_lock;
 
+                    std::lock_guard<std::mutex> lock{ types_lock };
                     auto & type = types[size];
                     if (!type)
                     {
@@ -0,0 +1,67 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    namespace _detail
+    {
+        // prints `str` as a JSON string literal, for the reports and traces the driver writes
+        inline void print_json_string(std::ostream & os, const std::string & str)
+        {
+            os << '"';
+            for (unsigned char c : str)
+            {
+                switch (c)
+                {
+                    case '"':
+                        os << "\\\"";
+                        break;
+
+                    case '\\':
+                        os << "\\\\";
+                        break;
+
+                    default:
+                        if (c < 0x20)
+                        {
+                            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+                        }
+
+                        else
+                        {
+                            os << c;
+                        }
+                }
+            }
+            os << '"';
+        }
+    }
+}
+}
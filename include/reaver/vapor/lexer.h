@@ -22,4 +22,6 @@
 
 #pragma once
 
+#include "lexer/incremental.h"
+#include "lexer/interner.h"
 #include "lexer/iterator.h"
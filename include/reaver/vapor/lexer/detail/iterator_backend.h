@@ -24,21 +24,37 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <thread>
 
-#include <reaver/optional.h>
-
 #include <reaver/semaphore.h>
 
-#include "../../position.h"
-#include "../errors.h"
-#include "../token.h"
 #include "lexer_node.h"
+#include "tokenizer.h"
 
 namespace reaver::vapor::lexer
 {
 inline namespace _v1
 {
+    enum class handoff_mode
+    {
+        per_token,
+        chunked
+    };
+
+    constexpr std::size_t default_chunk_size = 256;
+
+    enum class engine
+    {
+        threaded,
+        synchronous,
+        // splits the input into pieces and lexes them on the default executor, all before the first token is handed out
+        parallel
+    };
+
+    // roughly how many characters the parallel engine puts into a single piece
+    constexpr std::size_t default_piece_size = 1 << 16;
+
     namespace _detail
     {
         class _iterator_backend
@@ -46,259 +62,215 @@ inline namespace _v1
         public:
             friend class lexer::iterator;
 
-            template<typename Iter>
-            _iterator_backend(Iter begin, Iter end, std::shared_ptr<_lexer_node> & node) : _thread{ [&]() { _worker(begin, end); } }
+            _iterator_backend(handoff_mode mode) : _chunk_size{ mode == handoff_mode::chunked ? default_chunk_size : 1 }
+            {
+            }
+
+            virtual ~_iterator_backend() = default;
+
+        protected:
+            // makes sure that the node either has its successor set, or is marked as the last one
+            // throws if lexing has failed before the successor could be produced
+            virtual void _advance(_lexer_node & node) = 0;
+
+            const std::size_t _chunk_size;
+            std::shared_ptr<_lexer_node> _initial = nullptr;
+            std::exception_ptr _ex = nullptr;
+        };
+
+        template<typename Iter>
+        class _threaded_backend : public _iterator_backend
+        {
+        public:
+            _threaded_backend(Iter begin, Iter end, file_id file, handoff_mode mode) : _iterator_backend{ mode }, _lexer{ begin, end, file }, _thread{ [this]() { _worker(); } }
             {
                 _sem.wait();
-                node = std::move(_initial);
+
+                if (!_initial && _failed)
+                {
+                    _thread.join();
+                    std::rethrow_exception(_ex);
+                }
             }
 
-            ~_iterator_backend()
+            ~_threaded_backend()
             {
                 _end_flag = true;
                 _thread.join();
             }
 
         private:
-            template<typename Iter>
-            void _worker(Iter begin, Iter end, std::string filename = "")
+            virtual void _advance(_lexer_node & node) override
             {
-                std::shared_ptr<_lexer_node> node = nullptr;
+                if (node._done || node._has_next)
+                {
+                    return;
+                }
 
-                position pos;
-                pos.offset = -1;
-                pos.column = 0;
-                pos.line = 1;
-                pos.file = std::move(filename);
+                if (_failed)
+                {
+                    std::rethrow_exception(_ex);
+                }
 
-                auto get = [&]() -> optional<char32_t> {
-                    if (begin == end)
-                    {
-                        return {};
-                    }
+                node._sem.wait();
 
-                    if (*begin == U'\n')
-                    {
-                        pos.column = 0;
-                        ++pos.line;
-                    }
-                    else
-                    {
-                        ++pos.column;
-                    }
+                if (!node._has_next && _failed)
+                {
+                    std::rethrow_exception(_ex);
+                }
+            }
 
-                    ++pos.offset;
-                    return *begin++;
-                };
+            void _worker()
+            {
+                std::shared_ptr<_lexer_node> node = nullptr;
+                std::shared_ptr<_lexer_node> pending = nullptr;
 
-                auto peek = [&](std::size_t x = 0) -> optional<char32_t> {
-                    for (std::size_t i = 0; i < x; ++i)
+                auto publish = [&]() {
+                    if (!pending || pending->_tokens.empty())
                     {
-                        if (begin + i == end)
-                        {
-                            return {};
-                        }
+                        return;
                     }
 
-                    return *(begin + x);
-                };
-
-                auto generate_token = [&](token_type type, position begin, position end, std::u32string string) {
                     if (!node)
                     {
-                        _initial = std::make_shared<_lexer_node>(token{ type, std::move(string), range_type(begin, end) }, _ex);
+                        _initial = std::move(pending);
                         node = _initial;
                         _sem.notify();
                     }
 
                     else
                     {
-                        node->_next = std::make_shared<_lexer_node>(token{ type, std::move(string), range_type(begin, end) }, _ex);
+                        node->_set_next(std::move(pending));
                         node->_sem.notify();
                         node = node->_next;
                     }
                 };
 
-                auto notify = [&]() {
-                    if (!node)
+                try
+                {
+                    while (!_end_flag && !_lexer.done())
                     {
-                        _sem.notify();
-                        return;
+                        pending = std::make_shared<_lexer_node>(_chunk_size);
+                        _lexer.lex(pending->_tokens, _chunk_size);
+                        publish();
                     }
+                }
 
-                    node->_sem.notify();
-                };
-
-                auto is_white_space = [](char32_t c) { return c == U' ' || c == U'\t' || c == U'\n' || c == U'\r'; };
-
-                auto is_identifier_start = [](char32_t c) { return (c >= U'a' && c <= U'z') || (c >= U'A' && c <= U'Z') || c == U'_'; };
+                catch (...)
+                {
+                    // tokens lexed before the error must still be visible to the consumer
+                    publish();
 
-                auto is_decimal = [&](char32_t c) { return c >= U'0' && c <= U'9'; };
+                    _ex = std::current_exception();
+                    _failed = true;
+                }
 
-                auto is_identifier_char = [&](char32_t c) { return is_identifier_start(c) || is_decimal(c); };
+                if (!node)
+                {
+                    _sem.notify();
+                    return;
+                }
 
-                while (!_end_flag && begin != end)
+                if (!_failed)
                 {
-                    auto next = get();
+                    node->_done = true;
+                }
 
-                    if (is_white_space(*next))
-                    {
-                        continue;
-                    }
+                node->_sem.notify();
+            }
 
-                    auto p = pos;
-                    if (next == U'/')
-                    {
-                        auto second = peek();
-
-                        if (second == U'/')
-                        {
-                            while ((next = get()) && *next != U'\n')
-                            {
-                            }
-
-                            continue;
-                        }
-
-                        if (second == U'*')
-                        {
-                            get();
-
-                            while ((next = get()) && (second = peek()) && next != U'*' && second != U'/')
-                            {
-                            }
-
-                            if (next && second && next == U'*' && second == U'/')
-                            {
-                                get();
-                                continue;
-                            }
-
-                            _ex = std::make_exception_ptr(unterminated_comment{ { p, pos } });
-                            notify();
-                            return;
-                        }
-                    }
+            _tokenizer<Iter> _lexer;
+            std::atomic<bool> _end_flag{ false };
+            std::atomic<bool> _failed{ false };
+            semaphore _sem;
+            std::thread _thread;
+        };
 
-                    {
-                        auto second = peek();
-                        auto third = peek(1);
-
-                        if (second && third && symbols3.find(*next) != symbols3.end() && symbols3.at(*next).find(*second) != symbols3.at(*next).end()
-                            && symbols3.at(*next).at(*second).find(*third) != symbols3.at(*next).at(*second).end())
-                        {
-                            auto p = pos;
-                            generate_token(symbols3.at(*next).at(*second).at(*third), p, p + 3, { *next, *get(), *get() });
-                            continue;
-                        }
-
-                        else if (second && symbols2.find(*next) != symbols2.end() && symbols2.at(*next).find(*second) != symbols2.at(*next).end())
-                        {
-                            auto p = pos;
-                            generate_token(symbols2.at(*next).at(*second), p, p + 2, { *next, *get() });
-                            continue;
-                        }
-
-                        else if (symbols1.find(*next) != symbols1.end())
-                        {
-                            auto p = pos;
-                            generate_token(symbols1.at(*next), p, p + 1, { *next });
-                            continue;
-                        }
-                    }
+        // lexes on the consumer's thread, one block of tokens at a time, whenever the iterator
+        // steps over the last token lexed so far; no thread is ever created
+        // `offset` is the offset of the code point `begin` points at, for when only a part of a text is lexed
+        template<typename Iter>
+        class _synchronous_backend : public _iterator_backend
+        {
+        public:
+            _synchronous_backend(Iter begin, Iter end, file_id file, handoff_mode mode, std::uint32_t offset = 0)
+                : _iterator_backend{ mode }, _lexer{ begin, end, file, offset }
+            {
+                _initial = _lex_node();
+            }
 
-                    std::u32string variable_length;
+        private:
+            virtual void _advance(_lexer_node & node) override
+            {
+                std::lock_guard<std::mutex> lock{ _lock };
 
-                    if (next == U'"')
-                    {
-                        auto second = peek();
+                if (node._done || node._has_next)
+                {
+                    return;
+                }
 
-                        while (next && second && (second != U'"' || next == U'\\') && (second != U'\n' || next == U'\\'))
-                        {
-                            variable_length.push_back(*next);
+                auto next = _lex_node();
+                if (!next)
+                {
+                    node._done = true;
+                    return;
+                }
 
-                            next = get();
-                            second = peek();
-                        }
+                node._set_next(std::move(next));
+            }
 
-                        if (!next || second == U'\n')
-                        {
-                            _ex = std::make_exception_ptr(unterminated_string{ { p, p + variable_length.size() } });
-                            notify();
-                            return;
-                        }
+            std::shared_ptr<_lexer_node> _lex_node()
+            {
+                if (_ex)
+                {
+                    std::rethrow_exception(_ex);
+                }
 
-                        variable_length.push_back(*next);
-                        variable_length.push_back(*get());
+                auto node = std::make_shared<_lexer_node>(_chunk_size);
 
-                        generate_token(token_type::string, p, p + variable_length.size(), variable_length);
-                        continue;
-                    }
+                try
+                {
+                    _lexer.lex(node->_tokens, _chunk_size);
+                }
 
-                    if (is_identifier_start(*next))
+                catch (...)
+                {
+                    // same as with the threaded backend, the tokens before the error are still handed out
+                    _ex = std::current_exception();
+                    if (node->_tokens.empty())
                     {
-                        do
-                        {
-                            variable_length.push_back(*next);
-                        } while (peek() && is_identifier_char(*peek()) && (next = get()));
-
-                        if (keywords.find(variable_length) != keywords.end())
-                        {
-                            generate_token(keywords.at(variable_length), p, p + variable_length.size(), variable_length);
-                            continue;
-                        }
-
-                        generate_token(token_type::identifier, p, p + variable_length.size(), variable_length);
-                        continue;
+                        throw;
                     }
+                }
 
-                    if (is_decimal(*next))
-                    {
-                        do
-                        {
-                            variable_length.push_back(*next);
-                        } while (peek() && is_decimal(*peek()) && (next = get()));
-
-                        generate_token(token_type::integer, p, p + variable_length.size(), variable_length);
-
-                        if (next && is_identifier_start(*next))
-                        {
-                            variable_length.clear();
-
-                            do
-                            {
-                                variable_length.push_back(*next);
-                            } while (peek() && is_identifier_char(*peek()) && (next = get()));
-
-                            generate_token(token_type::integer_suffix, p, p + variable_length.size(), variable_length);
-                        }
-
-                        continue;
-                    }
+                return node->_tokens.empty() ? nullptr : node;
+            }
 
-                    _ex = std::make_exception_ptr(exception(logger::fatal) << "stray character in file: " << utf8({ *next }));
-                    notify();
-                    return;
-                }
+            std::mutex _lock;
+            _tokenizer<Iter> _lexer;
+        };
 
-                if (node)
+        // hands out tokens that have been lexed before, all in a single node; nothing is lexed, and nothing but the
+        // tokens themselves is kept alive
+        class _tokens_backend : public _iterator_backend
+        {
+        public:
+            _tokens_backend(std::vector<token> tokens) : _iterator_backend{ handoff_mode::chunked }
+            {
+                if (tokens.empty())
                 {
-                    node->_done = true;
-                    node->_sem.notify();
+                    return;
                 }
 
-                else
-                {
-                    _sem.notify();
-                }
+                _initial = std::make_shared<_lexer_node>(0);
+                _initial->_tokens = std::move(tokens);
+                _initial->_done = true;
             }
 
-            std::atomic<bool> _end_flag{ false };
-            std::mutex _m;
-            std::shared_ptr<_lexer_node> _initial = nullptr;
-            semaphore _sem;
-            std::thread _thread;
-            std::exception_ptr _ex = nullptr;
+        private:
+            virtual void _advance(_lexer_node &) override
+            {
+            }
         };
     }
 }
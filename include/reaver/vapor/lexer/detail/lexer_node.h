@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include <reaver/semaphore.h>
 
@@ -38,41 +40,52 @@ inline namespace _v1
     {
         class _iterator_backend;
 
+        template<typename Iter>
+        class _threaded_backend;
+
+        template<typename Iter>
+        class _synchronous_backend;
+
+        template<typename Iter>
+        class _parallel_backend;
+
+        class _tokens_backend;
+
+        // a node holds a block of consecutive tokens; in the per-token hand-off mode every block
+        // has exactly one token, in the chunked mode the lexer fills a whole block before publishing it,
+        // so the consuming iterator only needs to synchronize with the lexer at block boundaries
         class _lexer_node
         {
         public:
             friend class lexer::iterator;
-            friend class _iterator_backend;
 
-            _lexer_node(token tok, std::exception_ptr & ex) : _token{ std::move(tok) }, _ex(ex)
+            template<typename Iter>
+            friend class _threaded_backend;
+
+            template<typename Iter>
+            friend class _synchronous_backend;
+
+            template<typename Iter>
+            friend class _parallel_backend;
+
+            friend class _tokens_backend;
+
+            _lexer_node(std::size_t capacity)
             {
+                _tokens.reserve(capacity);
             }
 
-            void wait_next()
+        private:
+            void _set_next(std::shared_ptr<_lexer_node> next)
             {
-                if (_done || _next)
-                {
-                    return;
-                }
-
-                if (_ex)
-                {
-                    std::rethrow_exception(_ex);
-                }
-
-                _sem.wait();
-
-                if (_ex)
-                {
-                    std::rethrow_exception(_ex);
-                }
+                _next = std::move(next);
+                _has_next = true;
             }
 
-        private:
             std::shared_ptr<_lexer_node> _next;
-            token _token;
+            std::vector<token> _tokens;
             semaphore _sem;
-            std::exception_ptr & _ex;
+            std::atomic<bool> _has_next{ false };
             std::atomic<bool> _done{ false };
         };
     }
@@ -0,0 +1,418 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <reaver/future.h>
+
+#include "iterator_backend.h"
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    namespace _detail
+    {
+        template<typename Iter>
+        struct _piece
+        {
+            Iter begin;
+            Iter end;
+            std::uint32_t offset;
+            // in code points
+            std::uint32_t length;
+        };
+
+        constexpr bool _is_interesting(char32_t c)
+        {
+            return c == U'"' || c == U'/' || c == U'\n';
+        }
+
+        // splits the input right after newlines at which the lexer is guaranteed to be between tokens:
+        // not inside a comment and not inside a string; the state machine below mirrors how the tokenizer
+        // decides where those begin and end, including the quirks (a quote after any backslash doesn't end a string)
+        template<typename Iter>
+        std::vector<_piece<Iter>> _split(Iter begin, Iter end, std::size_t piece_size)
+        {
+            enum class state
+            {
+                code,
+                line_comment,
+                block_comment,
+                string
+            };
+
+            std::vector<_piece<Iter>> pieces;
+
+            auto current = state::code;
+            auto piece_begin = begin;
+            std::uint32_t piece_offset = 0;
+            std::uint32_t offset = 0;
+            char32_t previous = 0;
+
+            auto it = begin;
+            auto skip = [&](std::pair<Iter, std::size_t> run) {
+                it = run.first;
+                offset += run.second;
+            };
+
+            while (it != end)
+            {
+                // in code, only quotes, slashes, newlines and whatever follows a slash matter; comment bodies go through the vectorized scanners
+                if (current == state::code && previous != U'/')
+                {
+                    if (!_is_interesting(*it))
+                    {
+                        do
+                        {
+                            ++it;
+                            ++offset;
+                        } while (it != end && !_is_interesting(*it));
+
+                        previous = 0;
+                        continue;
+                    }
+                }
+
+                else if (current == state::line_comment)
+                {
+                    skip(_runs<Iter>::find(U'\n', it, end));
+                    if (it == end)
+                    {
+                        break;
+                    }
+                }
+
+                else if (current == state::block_comment)
+                {
+                    skip(_runs<Iter>::find(U'*', it, end));
+                    if (it == end)
+                    {
+                        break;
+                    }
+                }
+
+                char32_t c = *it;
+
+                switch (current)
+                {
+                    case state::code:
+                        if (c == U'"')
+                        {
+                            current = state::string;
+                        }
+                        else if (previous == U'/' && c == U'/')
+                        {
+                            current = state::line_comment;
+                        }
+                        else if (previous == U'/' && c == U'*')
+                        {
+                            current = state::block_comment;
+                        }
+                        else if (c == U'\n' && offset + 1 - piece_offset >= piece_size)
+                        {
+                            auto next = std::next(it);
+                            pieces.push_back({ piece_begin, next, piece_offset, offset + 1 - piece_offset });
+                            piece_begin = next;
+                            piece_offset = offset + 1;
+                        }
+                        break;
+
+                    case state::line_comment:
+                        current = state::code;
+                        break;
+
+                    case state::block_comment:
+                        if (std::next(it) != end && *std::next(it) == U'/')
+                        {
+                            ++it;
+                            ++offset;
+                            current = state::code;
+                            // the slash that closes a comment can't open another one
+                            c = 0;
+                        }
+                        break;
+
+                    case state::string:
+                        // an unescaped newline is an error, which the lexer will report
+                        if ((c == U'"' || c == U'\n') && previous != U'\\')
+                        {
+                            current = state::code;
+                            c = 0;
+                        }
+                        break;
+                }
+
+                previous = c;
+                ++it;
+                ++offset;
+            }
+
+            if (piece_begin != end || pieces.empty())
+            {
+                pieces.push_back({ piece_begin, end, piece_offset, offset - piece_offset });
+            }
+
+            return pieces;
+        }
+
+        struct _lexed_piece
+        {
+            std::vector<token> tokens;
+            // if set, lexing the piece has failed after producing `tokens`
+            std::exception_ptr ex;
+            bool ready = false;
+        };
+
+        // lexes the pieces on the default executor, at most `window` pieces ahead of the one the consumer
+        // is waiting for, so that the tokens of the whole input don't have to be in memory at once; the consumer
+        // lexes the pieces no one has taken yet itself, so this finishes even if used from a thread of a busy,
+        // or single-threaded, executor
+        template<typename Iter>
+        class _piece_lexer : public std::enable_shared_from_this<_piece_lexer<Iter>>
+        {
+        public:
+            _piece_lexer(Iter begin, Iter end, file_id file, std::size_t piece_size, std::size_t window)
+                : _pieces{ _split(begin, end, piece_size) }, _results(_pieces.size()), _file{ file }, _window{ std::max<std::size_t>(window, 1) }
+            {
+            }
+
+            std::size_t size() const
+            {
+                return _pieces.size();
+            }
+
+            // pieces must be taken in order, each one once
+            _lexed_piece take(std::size_t i)
+            {
+                std::unique_lock<std::mutex> guard{ _lock };
+
+                _limit = i + std::min(_window, _pieces.size() - i);
+                // the first call starts all the helpers that fit in the window, later ones replace the helper that
+                // lexed the piece being taken now
+                for (auto count = i == 0 ? _limit - 1 : 1; count && _next < _limit; --count)
+                {
+                    _spawn();
+                }
+
+                while (!_results[i].ready)
+                {
+                    if (_next <= i)
+                    {
+                        auto index = _next++;
+                        ++_in_flight;
+                        guard.unlock();
+                        _lex(index);
+                        guard.lock();
+                        continue;
+                    }
+
+                    _finished.wait(guard);
+                }
+
+                return std::move(_results[i]);
+            }
+
+            // makes helpers that haven't started yet do nothing, and waits for the ones that have
+            // after this returns, the input is not accessed anymore
+            void cancel()
+            {
+                std::unique_lock<std::mutex> guard{ _lock };
+                _cancelled = true;
+                _finished.wait(guard, [&] { return _in_flight == 0; });
+            }
+
+        private:
+            void _spawn()
+            {
+                auto executor = default_executor();
+                if (!executor)
+                {
+                    return;
+                }
+
+                executor->push([self = this->shared_from_this()] {
+                    std::unique_lock<std::mutex> guard{ self->_lock };
+                    if (self->_cancelled || self->_next >= self->_limit)
+                    {
+                        return;
+                    }
+
+                    auto index = self->_next++;
+                    ++self->_in_flight;
+                    guard.unlock();
+                    self->_lex(index);
+                });
+            }
+
+            void _lex(std::size_t i)
+            {
+                _lexed_piece result;
+                _tokenizer<Iter> lexer{ _pieces[i].begin, _pieces[i].end, _file, _pieces[i].offset };
+                result.tokens.reserve(_pieces[i].length / 4);
+
+                try
+                {
+                    lexer.lex(result.tokens, std::numeric_limits<std::size_t>::max());
+                }
+
+                catch (...)
+                {
+                    result.ex = std::current_exception();
+                }
+
+                result.ready = true;
+
+                std::lock_guard<std::mutex> guard{ _lock };
+                _results[i] = std::move(result);
+                --_in_flight;
+                _finished.notify_all();
+            }
+
+            const std::vector<_piece<Iter>> _pieces;
+            std::vector<_lexed_piece> _results;
+            const file_id _file;
+            const std::size_t _window;
+
+            std::mutex _lock;
+            std::condition_variable _finished;
+            std::size_t _next = 0;
+            std::size_t _limit = 0;
+            std::size_t _in_flight = 0;
+            bool _cancelled = false;
+        };
+
+        template<typename Iter>
+        class _parallel_backend : public _iterator_backend
+        {
+        public:
+            _parallel_backend(Iter begin, Iter end, file_id file, handoff_mode mode, std::size_t piece_size = default_piece_size)
+                : _iterator_backend{ mode },
+                  _lexer{ std::make_shared<_piece_lexer<Iter>>(begin, end, file, piece_size, 2 * std::max(std::thread::hardware_concurrency(), 1u)) }
+            {
+                try
+                {
+                    _initial = _lex_node();
+                }
+
+                catch (...)
+                {
+                    _lexer->cancel();
+                    throw;
+                }
+            }
+
+            ~_parallel_backend()
+            {
+                _lexer->cancel();
+            }
+
+        private:
+            virtual void _advance(_lexer_node & node) override
+            {
+                std::lock_guard<std::mutex> lock{ _lock };
+
+                if (node._done || node._has_next)
+                {
+                    return;
+                }
+
+                auto next = _lex_node();
+                if (!next)
+                {
+                    node._done = true;
+                    return;
+                }
+
+                node._set_next(std::move(next));
+            }
+
+            // like in the other engines, tokens before the first error are still handed out, and the error
+            // is only thrown when the iterator tries to step past them
+            std::shared_ptr<_lexer_node> _lex_node()
+            {
+                if (_ex)
+                {
+                    std::rethrow_exception(_ex);
+                }
+
+                while (_next_piece < _lexer->size())
+                {
+                    auto piece = _lexer->take(_next_piece++);
+                    _ex = piece.ex;
+
+                    if (!piece.tokens.empty())
+                    {
+                        auto node = std::make_shared<_lexer_node>(0);
+                        node->_tokens = std::move(piece.tokens);
+                        return node;
+                    }
+
+                    if (_ex)
+                    {
+                        std::rethrow_exception(_ex);
+                    }
+                }
+
+                return nullptr;
+            }
+
+            std::shared_ptr<_piece_lexer<Iter>> _lexer;
+            std::size_t _next_piece = 0;
+            std::mutex _lock;
+        };
+    }
+
+    // lexes all of [begin, end) at once, in parallel; throws the first error the serial lexer would throw
+    template<typename Iter>
+    std::vector<token> lex_parallel(Iter begin, Iter end, file_id file = unknown_file, std::size_t piece_size = default_piece_size)
+    {
+        auto lexer = std::make_shared<_detail::_piece_lexer<Iter>>(begin, end, file, piece_size, std::numeric_limits<std::size_t>::max());
+        std::vector<token> ret;
+
+        for (std::size_t i = 0; i < lexer->size(); ++i)
+        {
+            auto piece = lexer->take(i);
+            ret.insert(ret.end(), std::make_move_iterator(piece.tokens.begin()), std::make_move_iterator(piece.tokens.end()));
+
+            if (piece.ex)
+            {
+                lexer->cancel();
+                std::rethrow_exception(piece.ex);
+            }
+        }
+
+        return ret;
+    }
+}
+}
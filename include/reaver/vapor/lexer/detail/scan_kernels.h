@@ -0,0 +1,216 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "../scan.h"
+
+// the generic scanning loops, instantiated for every instruction set in its own translation unit,
+// compiled with the flags that instruction set needs
+// everything here has internal linkage on purpose: a copy built for AVX2 must never be picked
+// by the linker for a translation unit built for the baseline
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    namespace scan
+    {
+        struct _implementation
+        {
+            const char32_t * (*skip_utf32)(char_class, const char32_t *, const char32_t *);
+            const char * (*skip_utf8)(char_class, const char *, const char *);
+            const char32_t * (*find_utf32)(char32_t, const char32_t *, const char32_t *);
+            const char * (*find_utf8)(char, const char *, const char *);
+            std::size_t (*count_code_points)(const char *, const char *);
+        };
+
+        // defined in scan_avx2.cpp; null if that wasn't compiled with AVX2 enabled
+        const _implementation * _avx2_implementation();
+
+        namespace
+        {
+            template<typename Char>
+            bool _is_of_class(char_class cls, Char c)
+            {
+                switch (cls)
+                {
+                    case char_class::white_space:
+                        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+
+                    case char_class::identifier:
+                        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+
+                    case char_class::decimal:
+                        return c >= '0' && c <= '9';
+                }
+
+                return false;
+            }
+
+            template<typename Char>
+            const Char * _scalar_skip(char_class cls, const Char * begin, const Char * end)
+            {
+                while (begin != end && _is_of_class(cls, *begin))
+                {
+                    ++begin;
+                }
+                return begin;
+            }
+
+            template<typename Char>
+            const Char * _scalar_find(Char c, const Char * begin, const Char * end)
+            {
+                while (begin != end && *begin != c)
+                {
+                    ++begin;
+                }
+                return begin;
+            }
+
+            inline bool _is_lead_byte(char c)
+            {
+                return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+            }
+
+            inline std::size_t _scalar_count_code_points(const char * begin, const char * end)
+            {
+                std::size_t count = 0;
+                for (; begin != end; ++begin)
+                {
+                    count += _is_lead_byte(*begin);
+                }
+                return count;
+            }
+
+            // Ops provides a vector type of `width` lanes of Ops::char_type, and the handful of operations
+            // the loops below need; comparisons are signed, which is fine, since all the interesting
+            // characters are ASCII, and anything above it is either negative (bytes) or larger (code points)
+            template<typename Ops>
+            struct _kernels
+            {
+                using char_type = typename Ops::char_type;
+                using vec = typename Ops::vec;
+
+                static constexpr std::uint32_t full_mask = Ops::width == 32 ? ~std::uint32_t{} : (std::uint32_t{ 1 } << Ops::width) - 1;
+
+                static vec in_range(vec v, char_type lo, char_type hi)
+                {
+                    return Ops::bit_and(Ops::greater(v, Ops::splat(lo - 1)), Ops::greater(Ops::splat(hi + 1), v));
+                }
+
+                template<char_class Class>
+                static vec classify(vec v)
+                {
+                    if constexpr (Class == char_class::white_space)
+                    {
+                        return Ops::bit_or(Ops::bit_or(Ops::equal(v, Ops::splat(' ')), Ops::equal(v, Ops::splat('\t'))),
+                            Ops::bit_or(Ops::equal(v, Ops::splat('\n')), Ops::equal(v, Ops::splat('\r'))));
+                    }
+
+                    else if constexpr (Class == char_class::identifier)
+                    {
+                        return Ops::bit_or(Ops::bit_or(in_range(v, 'a', 'z'), in_range(v, 'A', 'Z')), Ops::bit_or(in_range(v, '0', '9'), Ops::equal(v, Ops::splat('_'))));
+                    }
+
+                    else
+                    {
+                        return in_range(v, '0', '9');
+                    }
+                }
+
+                template<char_class Class>
+                static const char_type * skip(const char_type * begin, const char_type * end)
+                {
+                    while (end - begin >= static_cast<std::ptrdiff_t>(Ops::width))
+                    {
+                        auto mask = Ops::mask(classify<Class>(Ops::load(begin)));
+                        if (mask != full_mask)
+                        {
+                            return begin + __builtin_ctz(~mask);
+                        }
+                        begin += Ops::width;
+                    }
+
+                    return _scalar_skip(Class, begin, end);
+                }
+
+                static const char_type * skip(char_class cls, const char_type * begin, const char_type * end)
+                {
+                    switch (cls)
+                    {
+                        case char_class::white_space:
+                            return skip<char_class::white_space>(begin, end);
+                        case char_class::identifier:
+                            return skip<char_class::identifier>(begin, end);
+                        case char_class::decimal:
+                            return skip<char_class::decimal>(begin, end);
+                    }
+
+                    return begin;
+                }
+
+                static const char_type * find(char_type c, const char_type * begin, const char_type * end)
+                {
+                    auto needle = Ops::splat(c);
+                    while (end - begin >= static_cast<std::ptrdiff_t>(Ops::width))
+                    {
+                        auto mask = Ops::mask(Ops::equal(Ops::load(begin), needle));
+                        if (mask)
+                        {
+                            return begin + __builtin_ctz(mask);
+                        }
+                        begin += Ops::width;
+                    }
+
+                    return _scalar_find(c, begin, end);
+                }
+
+                static std::size_t count_code_points(const char_type * begin, const char_type * end)
+                {
+                    static_assert(std::is_same<char_type, char>::value);
+
+                    // lead bytes (and ASCII) are the ones greater than 0xBF, as signed
+                    auto last_continuation = Ops::splat(static_cast<char>(0xBF));
+
+                    std::size_t count = 0;
+                    while (end - begin >= static_cast<std::ptrdiff_t>(Ops::width))
+                    {
+                        count += __builtin_popcount(Ops::mask(Ops::greater(Ops::load(begin), last_continuation)));
+                        begin += Ops::width;
+                    }
+
+                    return count + _scalar_count_code_points(begin, end);
+                }
+            };
+
+            template<typename Utf32Ops, typename Utf8Ops>
+            constexpr _implementation _make_implementation()
+            {
+                return { &_kernels<Utf32Ops>::skip, &_kernels<Utf8Ops>::skip, &_kernels<Utf32Ops>::find, &_kernels<Utf8Ops>::find, &_kernels<Utf8Ops>::count_code_points };
+            }
+        }
+    }
+}
+}
@@ -0,0 +1,360 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2014-2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <reaver/optional.h>
+
+#include "../../position.h"
+#include "../../utf8_iterator.h"
+#include "../errors.h"
+#include "../interner.h"
+#include "../scan.h"
+#include "../tables.h"
+#include "../token.h"
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    namespace _detail
+    {
+        // finds the ends of runs of characters; each function returns the end of the run and its length in code points
+        // this one goes a character at a time, the specializations below hand inputs that are contiguous in memory
+        // to the vectorized scanners
+        template<typename Iter, typename = void>
+        struct _runs
+        {
+            static std::pair<Iter, std::size_t> skip(scan::char_class cls, Iter begin, Iter end)
+            {
+                std::size_t length = 0;
+                for (; begin != end && scan::is_of_class(cls, *begin); ++begin, ++length)
+                {
+                }
+                return { begin, length };
+            }
+
+            static std::pair<Iter, std::size_t> find(char32_t c, Iter begin, Iter end)
+            {
+                std::size_t length = 0;
+                for (; begin != end && *begin != c; ++begin, ++length)
+                {
+                }
+                return { begin, length };
+            }
+        };
+
+        template<typename Iter>
+        struct _runs<Iter,
+            std::enable_if_t<std::is_same<Iter, std::u32string::iterator>::value || std::is_same<Iter, std::u32string::const_iterator>::value
+                || std::is_same<Iter, const char32_t *>::value>>
+        {
+            static std::pair<Iter, std::size_t> skip(scan::char_class cls, Iter begin, Iter end)
+            {
+                if (begin == end)
+                {
+                    return { begin, 0 };
+                }
+
+                auto ptr = &*begin;
+                std::size_t length = scan::skip(cls, ptr, ptr + (end - begin)) - ptr;
+                return { begin + length, length };
+            }
+
+            static std::pair<Iter, std::size_t> find(char32_t c, Iter begin, Iter end)
+            {
+                if (begin == end)
+                {
+                    return { begin, 0 };
+                }
+
+                auto ptr = &*begin;
+                std::size_t length = scan::find(c, ptr, ptr + (end - begin)) - ptr;
+                return { begin + length, length };
+            }
+        };
+
+        template<>
+        struct _runs<utf8_iterator>
+        {
+            static std::pair<utf8_iterator, std::size_t> skip(scan::char_class cls, utf8_iterator begin, utf8_iterator end)
+            {
+                // all the classes are ASCII, so bytes are code points
+                auto found = scan::skip(cls, begin.base(), end.base());
+                return { { found, end.base() }, static_cast<std::size_t>(found - begin.base()) };
+            }
+
+            // only for ASCII `c`
+            static std::pair<utf8_iterator, std::size_t> find(char32_t c, utf8_iterator begin, utf8_iterator end)
+            {
+                auto found = scan::find(static_cast<char>(c), begin.base(), end.base());
+                return { { found, end.base() }, scan::count_code_points(begin.base(), found) };
+            }
+        };
+
+        // the actual lexing state machine; it doesn't care about threads, it only produces tokens
+        // when asked to, so it can be driven both by a worker thread and by the consuming thread
+        template<typename Iter>
+        class _tokenizer
+        {
+        public:
+            // `offset` is the offset of `begin` in the file, for when only a part of it is lexed
+            _tokenizer(Iter begin, Iter end, file_id file, std::uint32_t offset = 0) : _begin{ begin }, _end{ end }
+            {
+                _pos.offset = offset - 1;
+                _pos.file = file;
+            }
+
+            bool done() const
+            {
+                return _begin == _end;
+            }
+
+            // appends tokens to `out` until at least `count` tokens were appended or the input is exhausted
+            // lexing errors are thrown; tokens appended before the error are left in `out`
+            void lex(std::vector<token> & out, std::size_t count)
+            {
+                auto target = out.size() + count;
+
+                auto is_identifier_start = [](char32_t c) { return (c >= U'a' && c <= U'z') || (c >= U'A' && c <= U'Z') || c == U'_'; };
+
+                auto is_decimal = [&](char32_t c) { return scan::is_of_class(scan::char_class::decimal, c); };
+
+                auto is_identifier_char = [&](char32_t c) { return scan::is_of_class(scan::char_class::identifier, c); };
+
+                while (out.size() < target && _begin != _end)
+                {
+                    _skip(scan::char_class::white_space);
+                    if (_begin == _end)
+                    {
+                        break;
+                    }
+
+                    auto next = _get();
+
+                    auto p = _pos;
+                    if (next == U'/')
+                    {
+                        auto second = _peek();
+
+                        if (second == U'/')
+                        {
+                            // the newline itself is skipped as white space
+                            _skip_to(U'\n');
+                            continue;
+                        }
+
+                        if (second == U'*')
+                        {
+                            _get();
+
+                            while (true)
+                            {
+                                _skip_to(U'*');
+
+                                if (!_get())
+                                {
+                                    throw unterminated_comment{ { p, _pos } };
+                                }
+
+                                if (_peek() == U'/')
+                                {
+                                    _get();
+                                    break;
+                                }
+                            }
+
+                            continue;
+                        }
+                    }
+
+                    {
+                        auto second = _peek();
+                        auto third = _peek(1);
+
+                        auto match = match_operator(*next, second ? *second : 0, third ? *third : 0);
+                        if (match.length)
+                        {
+                            auto p = _pos;
+                            for (std::size_t i = 1; i < match.length; ++i)
+                            {
+                                _get();
+                            }
+                            out.push_back({ match.type, token_string::view(token_spellings[+match.type]), range_type(p, p + match.length) });
+                            continue;
+                        }
+                    }
+
+                    auto & variable_length = _buffer;
+                    variable_length.clear();
+
+                    if (next == U'"')
+                    {
+                        auto second = _peek();
+
+                        while (next && second && (second != U'"' || next == U'\\') && (second != U'\n' || next == U'\\'))
+                        {
+                            variable_length.push_back(*next);
+
+                            next = _get();
+                            second = _peek();
+                        }
+
+                        if (!next || second == U'\n')
+                        {
+                            throw unterminated_string{ { p, p + variable_length.size() } };
+                        }
+
+                        variable_length.push_back(*next);
+                        variable_length.push_back(*_get());
+
+                        out.push_back({ token_type::string, token_string{ variable_length }, range_type(p, p + variable_length.size()) });
+                        continue;
+                    }
+
+                    if (is_identifier_start(*next))
+                    {
+                        variable_length.push_back(*next);
+                        _append_run(scan::char_class::identifier, variable_length);
+
+                        if (auto keyword = find_keyword(variable_length))
+                        {
+                            out.push_back({ keyword->type, token_string::view(keyword->spelling), range_type(p, p + variable_length.size()) });
+                            continue;
+                        }
+
+                        identifier_id id{ variable_length };
+                        out.push_back({ token_type::identifier, token_string::view(id.string()), range_type(p, p + variable_length.size()), id });
+                        continue;
+                    }
+
+                    if (is_decimal(*next))
+                    {
+                        variable_length.push_back(*next);
+                        _append_run(scan::char_class::decimal, variable_length);
+
+                        out.push_back({ token_type::integer, token_string{ variable_length }, range_type(p, p + variable_length.size()) });
+
+                        if (next && is_identifier_start(*next))
+                        {
+                            variable_length.clear();
+
+                            do
+                            {
+                                variable_length.push_back(*next);
+                            } while (_peek() && is_identifier_char(*_peek()) && (next = _get()));
+
+                            out.push_back({ token_type::integer_suffix, token_string{ variable_length }, range_type(p, p + variable_length.size()) });
+                        }
+
+                        continue;
+                    }
+
+                    throw exception(logger::fatal) << "stray character in file: " << utf8({ *next });
+                }
+            }
+
+        private:
+            optional<char32_t> _get()
+            {
+                if (_begin == _end)
+                {
+                    return {};
+                }
+
+                ++_pos.offset;
+                return *_begin++;
+            }
+
+            void _advance_to(std::pair<Iter, std::size_t> run)
+            {
+                _begin = run.first;
+                _pos.offset += run.second;
+            }
+
+            void _skip(scan::char_class cls)
+            {
+                _advance_to(_runs<Iter>::skip(cls, _begin, _end));
+            }
+
+            // stops before `c`, or at the end of the input
+            void _skip_to(char32_t c)
+            {
+                _advance_to(_runs<Iter>::find(c, _begin, _end));
+            }
+
+            void _append_run(scan::char_class cls, std::u32string & buffer)
+            {
+                auto run = _runs<Iter>::skip(cls, _begin, _end);
+
+                // for anything but random access iterators, append() goes through a temporary string
+                if constexpr (std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>::value)
+                {
+                    buffer.append(_begin, run.first);
+                }
+                else
+                {
+                    for (auto it = _begin; it != run.first; ++it)
+                    {
+                        buffer.push_back(*it);
+                    }
+                }
+
+                _advance_to(run);
+            }
+
+            optional<char32_t> _peek(std::size_t x = 0)
+            {
+                // Iter is only a forward iterator when decoding UTF-8
+                auto it = _begin;
+                for (std::size_t i = 0; i < x; ++i)
+                {
+                    if (it == _end)
+                    {
+                        return {};
+                    }
+                    ++it;
+                }
+
+                if (it == _end)
+                {
+                    return {};
+                }
+
+                return *it;
+            }
+
+            Iter _begin;
+            Iter _end;
+            position _pos;
+            // reused between tokens, so that lexing doesn't allocate once it has grown enough
+            std::u32string _buffer;
+        };
+    }
+}
+}
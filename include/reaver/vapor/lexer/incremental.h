@@ -0,0 +1,60 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../source_file.h"
+#include "token.h"
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    // replaces the code points [begin, end) of a text with `replacement`; the offsets are in the text before the edit
+    struct text_edit
+    {
+        std::uint32_t begin;
+        std::uint32_t end;
+        std::u32string replacement;
+    };
+
+    void apply_edit(std::u32string & text, const text_edit & edit);
+
+    // tokens [first, first + removed) of the old stream were replaced with tokens [first, first + inserted) of the new one;
+    // the tokens after them are the same, only moved by the difference in length of the edited text
+    struct token_change
+    {
+        std::size_t first;
+        std::size_t removed;
+        std::size_t inserted;
+    };
+
+    // updates `tokens`, lexed from a text before `edit`, to match `text`, the same text after `edit`
+    // only the damaged region is lexed again, up to the first token that also starts a token of the old stream;
+    // errors are thrown like from the iterator, and leave `tokens` unchanged
+    token_change relex(std::vector<token> & tokens, const std::u32string & text, const text_edit & edit, file_id file = unknown_file);
+}
+}
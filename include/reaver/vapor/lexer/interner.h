@@ -0,0 +1,116 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "../utf.h"
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    namespace _detail
+    {
+        std::uint32_t _intern_id(std::u32string_view str);
+        const std::u32string & _interned(std::uint32_t id);
+    }
+
+    // returns a view of a copy of `str` that lives until the end of the program
+    // equal strings are always given the same storage; safe to call from multiple threads
+    std::u32string_view intern(std::u32string_view str);
+
+    // a stable ID of an interned string; equal strings always get the same ID, so comparing and hashing
+    // identifiers doesn't need to look at their characters
+    // the empty string has the ID 0, which is also the ID of a default constructed object
+    class identifier_id
+    {
+    public:
+        identifier_id() = default;
+
+        identifier_id(std::u32string_view str) : _value{ str.empty() ? 0 : _detail::_intern_id(str) }
+        {
+        }
+
+        identifier_id(const std::u32string & str) : identifier_id{ std::u32string_view{ str } }
+        {
+        }
+
+        identifier_id(const char32_t * str) : identifier_id{ std::u32string_view{ str } }
+        {
+        }
+
+        std::uint32_t value() const
+        {
+            return _value;
+        }
+
+        // the same storage as returned by intern()
+        std::u32string_view string() const
+        {
+            return _value ? std::u32string_view{ _detail::_interned(_value) } : std::u32string_view{};
+        }
+
+        std::u32string str() const
+        {
+            return std::u32string{ string() };
+        }
+
+        explicit operator bool() const
+        {
+            return _value != 0;
+        }
+
+    private:
+        std::uint32_t _value = 0;
+    };
+
+    inline bool operator==(identifier_id lhs, identifier_id rhs)
+    {
+        return lhs.value() == rhs.value();
+    }
+
+    inline bool operator!=(identifier_id lhs, identifier_id rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    inline bool operator<(identifier_id lhs, identifier_id rhs)
+    {
+        return lhs.value() < rhs.value();
+    }
+}
+}
+
+namespace std
+{
+template<>
+struct hash<::reaver::vapor::lexer::identifier_id>
+{
+    std::size_t operator()(::reaver::vapor::lexer::identifier_id id) const
+    {
+        return std::hash<std::uint32_t>()(id.value());
+    }
+};
+}
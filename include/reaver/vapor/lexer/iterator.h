@@ -24,8 +24,11 @@
 
 #include <memory>
 #include <type_traits>
+#include <vector>
 
+#include "../source_file.h"
 #include "detail/iterator_backend.h"
+#include "detail/parallel_backend.h"
 
 namespace reaver::vapor::lexer
 {
@@ -37,10 +40,65 @@ inline namespace _v1
         iterator() = default;
 
         template<typename Iter, typename std::enable_if<std::is_same<typename std::iterator_traits<Iter>::value_type, char32_t>::value, int>::type = 0>
-        iterator(Iter begin, Iter end) : _backend{ std::make_shared<_detail::_iterator_backend>(begin, end, _node) }
+        iterator(Iter begin, Iter end, handoff_mode mode = handoff_mode::per_token) : iterator{ begin, end, engine::threaded, mode }
         {
         }
 
+        template<typename Iter, typename std::enable_if<std::is_same<typename std::iterator_traits<Iter>::value_type, char32_t>::value, int>::type = 0>
+        iterator(Iter begin, Iter end, engine eng, handoff_mode mode = handoff_mode::per_token) : iterator{ begin, end, unknown_file, eng, mode }
+        {
+        }
+
+        // positions of the tokens will refer to `file`, so diagnostics can show lines and columns
+        iterator(const source_file & file, engine eng = engine::threaded, handoff_mode mode = handoff_mode::per_token)
+        {
+            if (file.is_utf8())
+            {
+                *this = iterator{ file.utf8_begin(), file.utf8_end(), file.id(), eng, mode };
+            }
+
+            else
+            {
+                *this = iterator{ file.contents().begin(), file.contents().end(), file.id(), eng, mode };
+            }
+        }
+
+        template<typename Iter, typename std::enable_if<std::is_same<typename std::iterator_traits<Iter>::value_type, char32_t>::value, int>::type = 0>
+        iterator(Iter begin, Iter end, file_id file, engine eng, handoff_mode mode = handoff_mode::per_token)
+        {
+            if (eng == engine::synchronous)
+            {
+                _backend = std::make_shared<_detail::_synchronous_backend<Iter>>(begin, end, file, mode);
+            }
+
+            else if (eng == engine::parallel)
+            {
+                _backend = std::make_shared<_detail::_parallel_backend<Iter>>(begin, end, file, mode);
+            }
+
+            else
+            {
+                _backend = std::make_shared<_detail::_threaded_backend<Iter>>(begin, end, file, mode);
+            }
+
+            _node = std::move(_backend->_initial);
+        }
+
+        // lexes the rest of a text, starting at the code point `begin` points at, which is at `start` in that text;
+        // the text before it is assumed to end with a whole token, so this is only meant for resuming at a token boundary
+        template<typename Iter, typename std::enable_if<std::is_same<typename std::iterator_traits<Iter>::value_type, char32_t>::value, int>::type = 0>
+        iterator(Iter begin, Iter end, position start, handoff_mode mode = handoff_mode::per_token)
+            : _backend{ std::make_shared<_detail::_synchronous_backend<Iter>>(begin, end, start.file, mode, start.offset) }
+        {
+            _node = std::move(_backend->_initial);
+        }
+
+        // walks the given tokens, as if they were lexed again
+        explicit iterator(std::vector<token> tokens) : _backend{ std::make_shared<_detail::_tokens_backend>(std::move(tokens)) }
+        {
+            _node = std::move(_backend->_initial);
+        }
+
         explicit operator bool() const
         {
             return _node != nullptr;
@@ -48,19 +106,22 @@ inline namespace _v1
 
         bool operator!=(const iterator & other) const
         {
-            return _node != other._node;
+            return !(*this == other);
         }
 
         iterator & operator++()
         {
             if (_node)
             {
-                if (!_node->_next)
+                if (++_index < _node->_tokens.size())
                 {
-                    _node->wait_next();
+                    return *this;
                 }
 
+                _backend->_advance(*_node);
+
                 _node = _node->_next;
+                _index = 0;
             }
 
             return *this;
@@ -75,32 +136,33 @@ inline namespace _v1
 
         token & operator*()
         {
-            return _node->_token;
+            return _node->_tokens[_index];
         }
 
         const token & operator*() const
         {
-            return _node->_token;
+            return _node->_tokens[_index];
         }
 
         token * operator->()
         {
-            return &_node->_token;
+            return &_node->_tokens[_index];
         }
 
         const token * operator->() const
         {
-            return &_node->_token;
+            return &_node->_tokens[_index];
         }
 
         bool operator==(const iterator & rhs) const
         {
             // throw assert _backend == rhs._backend
-            return _node == rhs._node;
+            return _node == rhs._node && _index == rhs._index;
         }
 
     private:
         std::shared_ptr<_detail::_lexer_node> _node = nullptr;
+        std::size_t _index = 0;
         std::shared_ptr<_detail::_iterator_backend> _backend = nullptr;
     };
 }
@@ -0,0 +1,84 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstddef>
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    // vectorized scanning of the runs of characters the lexer skips over most often
+    // the implementation is chosen at startup, based on what the CPU supports
+    namespace scan
+    {
+        enum class char_class
+        {
+            white_space,
+            identifier,
+            decimal
+        };
+
+        constexpr bool is_of_class(char_class cls, char32_t c)
+        {
+            switch (cls)
+            {
+                case char_class::white_space:
+                    return c == U' ' || c == U'\t' || c == U'\n' || c == U'\r';
+
+                case char_class::identifier:
+                    return (c >= U'a' && c <= U'z') || (c >= U'A' && c <= U'Z') || (c >= U'0' && c <= U'9') || c == U'_';
+
+                case char_class::decimal:
+                    return c >= U'0' && c <= U'9';
+            }
+
+            return false;
+        }
+
+        // the first character in [begin, end) that is not of class `cls`, or `end`
+        // the classes are all ASCII, so for UTF-8 the number of bytes skipped is also the number of code points
+        const char32_t * skip(char_class cls, const char32_t * begin, const char32_t * end);
+        const char * skip(char_class cls, const char * begin, const char * end);
+
+        // the first occurrence of `c` in [begin, end), or `end`
+        const char32_t * find(char32_t c, const char32_t * begin, const char32_t * end);
+        const char * find(char c, const char * begin, const char * end);
+
+        // assumes that [begin, end) doesn't start or end in the middle of a sequence
+        std::size_t count_code_points(const char * begin, const char * end);
+
+        enum class isa
+        {
+            scalar,
+            sse2,
+            avx2
+        };
+
+        bool supported(isa set);
+        isa selected();
+        // for tests and benchmarks; must not be called while anything is being lexed
+        void select(isa set);
+    }
+}
+}
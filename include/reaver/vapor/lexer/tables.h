@@ -0,0 +1,309 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "../utf.h"
+#include "token.h"
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    // the tables the lexer recognizes keywords and operators with, all generated at compile time
+    // the unordered maps in token.h describe the same language; tests/lexer/tables.cpp checks that they agree
+
+    struct keyword
+    {
+        std::u32string_view spelling;
+        token_type type;
+    };
+
+    struct operator_match
+    {
+        token_type type;
+        std::size_t length;
+    };
+
+    namespace _detail
+    {
+        constexpr keyword _keywords[] = {
+            { U"true", token_type::boolean },
+            { U"false", token_type::boolean },
+
+            { U"module", token_type::module },
+            { U"import", token_type::import },
+            { U"let", token_type::let },
+            { U"return", token_type::return_ },
+            { U"function", token_type::function },
+            { U"struct", token_type::struct_ },
+
+            { U"typeclass", token_type::typeclass },
+            { U"implicit", token_type::implicit },
+            { U"instance", token_type::instance },
+            { U"default", token_type::default_ },
+            { U"with", token_type::with },
+
+            { U"if", token_type::if_ },
+            { U"else", token_type::else_ },
+        };
+
+        struct _operator
+        {
+            std::u32string_view spelling;
+            token_type type;
+        };
+
+        constexpr _operator _operators[] = {
+            { U".", token_type::dot },
+            { U",", token_type::comma },
+            { U"{", token_type::curly_bracket_open },
+            { U"}", token_type::curly_bracket_close },
+            { U"[", token_type::square_bracket_open },
+            { U"]", token_type::square_bracket_close },
+            { U"(", token_type::round_bracket_open },
+            { U")", token_type::round_bracket_close },
+            { U"<", token_type::angle_bracket_open },
+            { U">", token_type::angle_bracket_close },
+            { U":", token_type::colon },
+            { U";", token_type::semicolon },
+            { U"=", token_type::assign },
+
+            { U"!", token_type::logical_not },
+            { U"~", token_type::bitwise_not },
+
+            { U"+", token_type::plus },
+            { U"-", token_type::minus },
+            { U"*", token_type::star },
+            { U"/", token_type::slash },
+            { U"%", token_type::modulo },
+            { U"&", token_type::bitwise_and },
+            { U"|", token_type::bitwise_or },
+            { U"^", token_type::bitwise_xor },
+            { U"λ", token_type::lambda },
+
+            { U"<<", token_type::left_shift },
+            { U"<=", token_type::less_equal },
+            { U">>", token_type::right_shift },
+            { U">=", token_type::greater_equal },
+            { U"=>", token_type::block_value },
+            { U"==", token_type::equals },
+            { U"&&", token_type::logical_and },
+            { U"&=", token_type::bitwise_and_assignment },
+            { U"||", token_type::logical_or },
+            { U"|=", token_type::bitwise_or_assignment },
+            { U"!=", token_type::not_equals },
+            { U"~=", token_type::bitwise_not_assignment },
+            { U"+=", token_type::plus_assignment },
+            { U"->", token_type::indirection },
+            { U"-=", token_type::minus_assignment },
+            { U"*=", token_type::star_assignment },
+            { U"/=", token_type::slash_assignment },
+            { U"%=", token_type::modulo_assignment },
+            { U"^=", token_type::bitwise_xor_assignment },
+
+            { U"->>", token_type::map },
+        };
+
+        constexpr std::size_t _max_operator_length = 3;
+        constexpr std::size_t _ascii = 128;
+
+        // a DFA over the ASCII operators; state 0 is the initial state, and since nothing transitions
+        // into it, 0 also means "no transition"
+        struct _operator_dfa
+        {
+            static constexpr std::size_t max_states = 64;
+
+            std::uint8_t transitions[max_states][_ascii] = {};
+            token_type accepts[max_states] = {};
+            std::size_t states = 1;
+        };
+
+        constexpr _operator_dfa _build_operator_dfa()
+        {
+            _operator_dfa dfa{};
+
+            for (auto && op : _operators)
+            {
+                if (op.spelling[0] >= _ascii)
+                {
+                    continue;
+                }
+
+                std::size_t state = 0;
+                for (auto c : op.spelling)
+                {
+                    if (!dfa.transitions[state][c])
+                    {
+                        dfa.transitions[state][c] = dfa.states++;
+                    }
+                    state = dfa.transitions[state][c];
+                }
+
+                dfa.accepts[state] = op.type;
+            }
+
+            return dfa;
+        }
+
+        constexpr _operator_dfa _operator_table = _build_operator_dfa();
+
+        constexpr std::size_t _keyword_slots = 32;
+
+        constexpr std::size_t _max_keyword_length()
+        {
+            std::size_t ret = 0;
+            for (auto && kw : _keywords)
+            {
+                ret = kw.spelling.size() > ret ? kw.spelling.size() : ret;
+            }
+            return ret;
+        }
+
+        // only called for non-empty strings
+        constexpr std::size_t _keyword_hash(std::u32string_view str, std::uint32_t seed)
+        {
+            std::uint32_t hash = seed ^ static_cast<std::uint32_t>(str.size());
+            hash = (hash ^ str[0]) * 16777619u;
+            hash = (hash ^ str[str.size() / 2]) * 16777619u;
+            hash = (hash ^ str[str.size() - 1]) * 16777619u;
+            return (hash >> 16) % _keyword_slots;
+        }
+
+        // the first seed for which no two keywords end up in the same slot
+        constexpr std::uint32_t _find_keyword_seed()
+        {
+            for (std::uint32_t seed = 1; seed < 100000; ++seed)
+            {
+                bool used[_keyword_slots] = {};
+                bool perfect = true;
+
+                for (auto && kw : _keywords)
+                {
+                    auto slot = _keyword_hash(kw.spelling, seed);
+                    if (used[slot])
+                    {
+                        perfect = false;
+                        break;
+                    }
+                    used[slot] = true;
+                }
+
+                if (perfect)
+                {
+                    return seed;
+                }
+            }
+
+            return 0;
+        }
+
+        constexpr std::uint32_t _keyword_seed = _find_keyword_seed();
+        static_assert(_keyword_seed != 0, "no perfect hash found for the keywords; add more slots");
+
+        constexpr std::array<std::int8_t, _keyword_slots> _build_keyword_table()
+        {
+            std::array<std::int8_t, _keyword_slots> table{};
+            for (auto && slot : table)
+            {
+                slot = -1;
+            }
+
+            for (std::size_t i = 0; i < std::size(_keywords); ++i)
+            {
+                table[_keyword_hash(_keywords[i].spelling, _keyword_seed)] = i;
+            }
+
+            return table;
+        }
+
+        constexpr std::array<std::int8_t, _keyword_slots> _keyword_table = _build_keyword_table();
+    }
+
+    constexpr std::size_t keyword_count = std::size(_detail::_keywords);
+
+    // returns nullptr for anything that isn't a keyword
+    constexpr const keyword * find_keyword(std::u32string_view str)
+    {
+        if (str.empty() || str.size() > _detail::_max_keyword_length())
+        {
+            return nullptr;
+        }
+
+        auto slot = _detail::_keyword_table[_detail::_keyword_hash(str, _detail::_keyword_seed)];
+        if (slot < 0 || _detail::_keywords[slot].spelling != str)
+        {
+            return nullptr;
+        }
+
+        return &_detail::_keywords[slot];
+    }
+
+    // the longest operator that the given characters start with; characters past the end of the input should be passed as 0
+    // returns a match of length 0 and type none if there's no such operator
+    constexpr operator_match match_operator(char32_t first, char32_t second, char32_t third)
+    {
+        if (first >= _detail::_ascii)
+        {
+            // the non-ASCII operators are all single characters
+            for (auto && op : _detail::_operators)
+            {
+                if (op.spelling[0] == first)
+                {
+                    return { op.type, 1 };
+                }
+            }
+
+            return { token_type::none, 0 };
+        }
+
+        const char32_t chars[_detail::_max_operator_length] = { first, second, third };
+
+        operator_match ret{ token_type::none, 0 };
+        std::size_t state = 0;
+
+        for (std::size_t i = 0; i < _detail::_max_operator_length && chars[i] < _detail::_ascii; ++i)
+        {
+            state = _detail::_operator_table.transitions[state][chars[i]];
+            if (!state)
+            {
+                break;
+            }
+
+            if (_detail::_operator_table.accepts[state] != token_type::none)
+            {
+                ret = { _detail::_operator_table.accepts[state], i + 1 };
+            }
+        }
+
+        return ret;
+    }
+
+    static_assert(match_operator(U'-', U'>', U'>').type == token_type::map);
+    static_assert(match_operator(U'-', U'>', U'x').type == token_type::indirection);
+    static_assert(find_keyword(U"function")->type == token_type::function);
+    static_assert(!find_keyword(U"functions"));
+}
+}
@@ -23,21 +23,25 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <ostream>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 #include <reaver/exception.h>
 #include <reaver/relaxed_constexpr.h>
 
 #include "../range.h"
 #include "../utf.h"
+#include "interner.h"
 
 namespace reaver::vapor::lexer
 {
 inline namespace _v1
 {
-    enum class token_type : std::size_t
+    enum class token_type : std::uint32_t
     {
         none,
         identifier,
@@ -158,7 +162,10 @@ inline namespace _v1
     }
 
     extern std::array<std::string, +token_type::count> token_types;
+    // spellings of keywords and punctuators, in UTF-32; for other token types this is just the name of the type
+    extern const std::array<std::u32string, +token_type::count> token_spellings;
 
+    // the lexer itself uses the generated tables in tables.h; these are the reference they are tested against
     extern const std::unordered_map<std::u32string, token_type> keywords;
     extern const std::unordered_map<char32_t, token_type> symbols1;
     extern const std::unordered_map<char32_t, std::unordered_map<char32_t, token_type>> symbols2;
@@ -166,6 +173,113 @@ inline namespace _v1
 
     class iterator;
 
+    // the text of a token
+    // most tokens don't own their text: keywords and punctuators refer to their static spellings,
+    // and identifiers refer to the interned string table; literals (strings and integers) hold an
+    // owned copy, so that the interned table, which is never freed, doesn't grow with every number
+    // ever lexed
+    class token_string
+    {
+    public:
+        token_string() = default;
+
+        token_string(std::u32string owned) : _owned{ std::make_unique<std::u32string>(std::move(owned)) }, _view{ *_owned }
+        {
+        }
+
+        token_string(const char32_t * str) : token_string{ std::u32string{ str } }
+        {
+        }
+
+        token_string(const token_string & other)
+            : _owned{ other._owned ? std::make_unique<std::u32string>(*other._owned) : nullptr }, _view{ _owned ? std::u32string_view{ *_owned } : other._view }
+        {
+        }
+
+        token_string(token_string && other) noexcept : _owned{ std::move(other._owned) }, _view{ std::exchange(other._view, {}) }
+        {
+        }
+
+        token_string & operator=(const token_string & other)
+        {
+            return *this = token_string{ other };
+        }
+
+        token_string & operator=(token_string && other) noexcept
+        {
+            _owned = std::move(other._owned);
+            _view = std::exchange(other._view, {});
+            return *this;
+        }
+
+        // the storage `str` refers to must outlive every copy of the token
+        static token_string view(std::u32string_view str)
+        {
+            token_string ret;
+            ret._view = str;
+            return ret;
+        }
+
+        operator std::u32string_view() const
+        {
+            return _view;
+        }
+
+        std::u32string str() const
+        {
+            return std::u32string{ _view };
+        }
+
+        const char32_t * data() const
+        {
+            return _view.data();
+        }
+
+        std::size_t size() const
+        {
+            return _view.size();
+        }
+
+        bool empty() const
+        {
+            return _view.empty();
+        }
+
+        auto begin() const
+        {
+            return _view.begin();
+        }
+
+        auto end() const
+        {
+            return _view.end();
+        }
+
+    private:
+        std::unique_ptr<std::u32string> _owned;
+        std::u32string_view _view;
+    };
+
+    inline bool operator==(const token_string & lhs, const token_string & rhs)
+    {
+        return std::u32string_view{ lhs } == std::u32string_view{ rhs };
+    }
+
+    inline bool operator==(const token_string & lhs, const char32_t * rhs)
+    {
+        return std::u32string_view{ lhs } == rhs;
+    }
+
+    inline bool operator!=(const token_string & lhs, const token_string & rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    inline bool operator!=(const token_string & lhs, const char32_t * rhs)
+    {
+        return !(lhs == rhs);
+    }
+
     struct token
     {
         token()
@@ -176,12 +290,14 @@ inline namespace _v1
         token & operator=(const token &) = default;
         token & operator=(token &&) = default;
 
-        token(token_type t, std::u32string s, range_type r) : type{ t }, string{ std::move(s) }, range{ std::move(r) }
+        token(token_type t, token_string s, range_type r, identifier_id i = {}) : type{ t }, id{ i }, string{ std::move(s) }, range{ std::move(r) }
         {
         }
 
         token_type type;
-        std::u32string string;
+        // set by the lexer for identifiers; fits in the padding after `type`
+        identifier_id id;
+        token_string string;
         range_type range;
     };
 
@@ -0,0 +1,68 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "utf.h"
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    // a read-only, private mapping of a whole file
+    class mapped_file
+    {
+    public:
+        mapped_file() = default;
+        mapped_file(const std::string & path);
+        ~mapped_file();
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file & operator=(const mapped_file &) = delete;
+
+        mapped_file(mapped_file && other) noexcept;
+        mapped_file & operator=(mapped_file && other) noexcept;
+
+        const char * data() const
+        {
+            return _data;
+        }
+
+        std::size_t size() const
+        {
+            return _size;
+        }
+
+        std::string_view view() const
+        {
+            return { _data, _size };
+        }
+
+    private:
+        const char * _data = nullptr;
+        std::size_t _size = 0;
+    };
+}
+}
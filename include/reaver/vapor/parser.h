@@ -24,6 +24,9 @@
 
 #include "parser/ast.h"
 #include "parser/binary_expression.h"
+#include "parser/cache.h"
 #include "parser/expr.h"
+#include "parser/incremental.h"
 #include "parser/lambda_expression.h"
+#include "parser/serialization.h"
 #include "parser/unary_expression.h"
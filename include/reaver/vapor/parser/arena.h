@@ -0,0 +1,166 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace reaver::vapor::parser
+{
+inline namespace _v1
+{
+    // a bump allocator that the nodes of a single module are allocated from
+    // nothing is returned to the system before the arena is destroyed, at which point all of the memory is released at once
+    // small blocks that are deallocated earlier (the parser moves subtrees around a lot while building them) are kept on
+    // free lists and reused by the following allocations of the same size
+    class arena
+    {
+    public:
+        arena() = default;
+        arena(const arena &) = delete;
+        arena & operator=(const arena &) = delete;
+
+        void * allocate(std::size_t size);
+        void deallocate(void * ptr, std::size_t size) noexcept;
+
+        std::size_t allocated_bytes() const
+        {
+            return _allocated;
+        }
+
+        std::size_t block_count() const
+        {
+            return _blocks.size();
+        }
+
+        static constexpr std::size_t alignment = alignof(std::max_align_t);
+        static constexpr std::size_t max_recycled_size = 4096;
+
+    private:
+        struct _free_block
+        {
+            _free_block * next;
+        };
+
+        std::vector<std::unique_ptr<char[]>> _blocks;
+        _free_block * _free[max_recycled_size / alignment + 1] = {};
+        char * _current = nullptr;
+        char * _end = nullptr;
+        std::size_t _next_block_size = 16 * 1024;
+        std::size_t _allocated = 0;
+    };
+
+    // makes allocate_node() use the given arena on the current thread for the lifetime of the scope
+    // a null arena means the heap
+    class arena_scope
+    {
+    public:
+        arena_scope(arena * a);
+        ~arena_scope();
+
+        arena_scope(const arena_scope &) = delete;
+        arena_scope & operator=(const arena_scope &) = delete;
+
+    private:
+        arena * _previous;
+    };
+
+    // allocates from the arena of the innermost arena_scope on this thread, or from the heap if there is none
+    // every allocation remembers where it came from, so deallocate_node() can be called regardless of the current scope
+    void * allocate_node(std::size_t size);
+    void deallocate_node(void * ptr) noexcept;
+
+    // the allocator lives in its own namespace, so that the fmap below is only found through ADL and doesn't hide
+    // the general fmap from the code inside of the parser namespace
+    namespace _detail
+    {
+        template<typename T>
+        struct node_allocator
+        {
+            using value_type = T;
+            using is_always_equal = std::true_type;
+
+            node_allocator() = default;
+
+            template<typename U>
+            node_allocator(const node_allocator<U> &)
+            {
+            }
+
+            T * allocate(std::size_t n)
+            {
+                return static_cast<T *>(allocate_node(n * sizeof(T)));
+            }
+
+            void deallocate(T * ptr, std::size_t) noexcept
+            {
+                deallocate_node(ptr);
+            }
+        };
+
+        template<typename T, typename U>
+        bool operator==(const node_allocator<T> &, const node_allocator<U> &)
+        {
+            return true;
+        }
+
+        template<typename T, typename U>
+        bool operator!=(const node_allocator<T> &, const node_allocator<U> &)
+        {
+            return false;
+        }
+
+        // the rest of the compiler wants plain vectors out of fmap
+        template<typename T, typename F>
+        auto fmap(const std::vector<T, node_allocator<T>> & vec, F && f)
+        {
+            std::vector<std::decay_t<decltype(f(vec.front()))>> ret;
+            ret.reserve(vec.size());
+            for (auto && elem : vec)
+            {
+                ret.push_back(f(elem));
+            }
+            return ret;
+        }
+
+        template<typename T, typename F>
+        auto fmap(std::vector<T, node_allocator<T>> & vec, F && f)
+        {
+            std::vector<std::decay_t<decltype(f(vec.front()))>> ret;
+            ret.reserve(vec.size());
+            for (auto && elem : vec)
+            {
+                ret.push_back(f(elem));
+            }
+            return ret;
+        }
+    }
+
+    using _detail::node_allocator;
+
+    template<typename T>
+    using node_vector = std::vector<T, node_allocator<T>>;
+}
+}
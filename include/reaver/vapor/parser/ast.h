@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -39,16 +41,36 @@ inline namespace _v1
     class ast
     {
     public:
-        ast(lexer::iterator begin, lexer::iterator end = {})
+        ast(lexer::iterator begin,
+            lexer::iterator end = {},
+            node_allocation allocation = node_allocation::arena,
+            module_parsing parsing = module_parsing::sequential,
+            body_parsing bodies = body_parsing::eager)
         {
-            auto ctx = context{ begin, end, {} };
+            auto ctx = context{ begin, end, {}, allocation, parsing, bodies };
 
-            while (ctx.begin != ctx.end)
+            while (peek(ctx))
             {
                 _modules.push_back(parse_module(ctx));
             }
         }
 
+        // for modules that didn't come from the parser, like the ones loaded by deserialize(); `storage` is kept alive for
+        // as long as the tree is, for the text their tokens refer to
+        explicit ast(std::vector<module> modules, std::shared_ptr<const void> storage = nullptr)
+            : _modules{ std::move(modules) }, _storage{ std::move(storage) }
+        {
+        }
+
+        ast(const std::u32string & source, lexer::engine engine = lexer::engine::threaded)
+            : ast{ lexer::iterator{ source.begin(), source.end(), engine, lexer::handoff_mode::chunked } }
+        {
+        }
+
+        ast(const source_file & source, lexer::engine engine = lexer::engine::threaded) : ast{ lexer::iterator{ source, engine, lexer::handoff_mode::chunked } }
+        {
+        }
+
         auto begin()
         {
             return _modules.begin();
@@ -77,6 +99,7 @@ inline namespace _v1
 
     private:
         std::vector<module> _modules;
+        std::shared_ptr<const void> _storage;
     };
 
     inline std::ostream & operator<<(std::ostream & os, const ast & ast)
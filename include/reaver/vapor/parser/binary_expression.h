@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "../lexer/token.h"
 #include "../range.h"
 #include "expression.h"
@@ -37,55 +39,119 @@ inline namespace _v1
         lexer::token op;
         expression lhs;
         expression rhs;
+
+        // recursive_wrapper allocates these; inside of an arena_scope, they come from the arena of the module
+        static void * operator new(std::size_t size)
+        {
+            return allocate_node(size);
+        }
+
+        static void operator delete(void * ptr)
+        {
+            deallocate_node(ptr);
+        }
     };
 
     bool operator==(const binary_expression & lhs, const binary_expression & rhs);
 
-    const std::vector<lexer::token_type> & binary_operators();
-
-    inline bool is_binary_operator(lexer::token_type t)
+    enum class assoc
     {
-        return std::find(binary_operators().begin(), binary_operators().end(), t) != binary_operators().end();
-    }
+        right,
+        left
+    };
 
-    const std::unordered_map<lexer::token_type, std::size_t> & binary_operator_precedences();
+    struct binary_operator_info
+    {
+        bool is_binary = false;
+        // lower binds tighter
+        std::size_t precedence = 0;
+        assoc associativity = assoc::left;
+    };
 
-    inline std::size_t precedence(operator_context ctx)
+    namespace _detail
     {
-        if (ctx.type == operator_type::unary)
+        constexpr std::array<binary_operator_info, +lexer::token_type::count> _build_binary_operator_table()
         {
-            return 5;
+            std::array<binary_operator_info, +lexer::token_type::count> table{};
+
+            auto add = [&](lexer::token_type type, std::size_t precedence, assoc associativity = assoc::left) {
+                table[+type] = { true, precedence, associativity };
+            };
+
+            add(lexer::token_type::indirection, 0);
+
+            add(lexer::token_type::star, 10);
+            add(lexer::token_type::slash, 10);
+            add(lexer::token_type::modulo, 10);
+
+            add(lexer::token_type::plus, 15);
+            add(lexer::token_type::minus, 15);
+
+            add(lexer::token_type::left_shift, 20);
+            add(lexer::token_type::right_shift, 20);
+
+            add(lexer::token_type::less, 25);
+            add(lexer::token_type::less_equal, 25);
+            add(lexer::token_type::greater, 25);
+            add(lexer::token_type::greater_equal, 25);
+
+            add(lexer::token_type::equals, 30);
+            add(lexer::token_type::not_equals, 30);
+
+            add(lexer::token_type::bitwise_and, 35);
+            add(lexer::token_type::bitwise_xor, 40);
+            add(lexer::token_type::bitwise_or, 45);
+            add(lexer::token_type::logical_and, 50);
+            add(lexer::token_type::logical_or, 55);
+
+            for (auto type : { lexer::token_type::assign,
+                     lexer::token_type::plus_assignment,
+                     lexer::token_type::minus_assignment,
+                     lexer::token_type::star_assignment,
+                     lexer::token_type::slash_assignment,
+                     lexer::token_type::modulo_assignment,
+                     lexer::token_type::left_shift_assignment,
+                     lexer::token_type::right_shift_assignment,
+                     lexer::token_type::bitwise_and_assignment,
+                     lexer::token_type::bitwise_or_assignment,
+                     lexer::token_type::bitwise_xor_assignment,
+                     lexer::token_type::logical_and_assignment,
+                     lexer::token_type::logical_or_assignment })
+            {
+                add(type, 60, assoc::right);
+            }
+
+            return table;
         }
 
-        return binary_operator_precedences().at(ctx.op);
+        constexpr std::array<binary_operator_info, +lexer::token_type::count> _binary_operator_table = _build_binary_operator_table();
     }
 
-    enum class assoc
+    constexpr bool is_binary_operator(lexer::token_type t)
     {
-        right,
-        left
-    };
+        return +t < _detail::_binary_operator_table.size() && _detail::_binary_operator_table[+t].is_binary;
+    }
 
-    inline assoc associativity(lexer::token_type type)
+    constexpr std::size_t precedence(lexer::token_type t)
     {
-        static std::vector<lexer::token_type> right_assoc = { lexer::token_type::assign,
-            lexer::token_type::plus_assignment,
-            lexer::token_type::minus_assignment,
-            lexer::token_type::star_assignment,
-            lexer::token_type::slash_assignment,
-            lexer::token_type::left_shift_assignment,
-            lexer::token_type::right_shift_assignment,
-            lexer::token_type::bitwise_and_assignment,
-            lexer::token_type::bitwise_not_assignment,
-            lexer::token_type::bitwise_or_assignment,
-            lexer::token_type::bitwise_xor_assignment,
-            lexer::token_type::logical_and_assignment,
-            lexer::token_type::logical_or_assignment };
-
-        return std::find(right_assoc.begin(), right_assoc.end(), type) != right_assoc.end() ? assoc::right : assoc::left;
-    };
+        return _detail::_binary_operator_table[+t].precedence;
+    }
+
+    constexpr assoc associativity(lexer::token_type t)
+    {
+        return _detail::_binary_operator_table[+t].associativity;
+    }
+
+    // whether an operator is taken in by the operand of an operator of the given precedence
+    // with no enclosing operator, every binary operator is
+    inline bool binds_tighter(lexer::token_type t, const optional<std::size_t> & enclosing)
+    {
+        return !enclosing || precedence(t) < *enclosing || (precedence(t) == *enclosing && associativity(t) == assoc::right);
+    }
 
-    binary_expression parse_binary_expression(context & ctx, expression lhs);
+    // parses the chain of binary operators that follows lhs, for as long as they bind tighter than the enclosing operator
+    // the caller must have checked that the first of them does
+    expression parse_binary_expression(context & ctx, expression lhs);
 
     void print(const binary_expression & expr, std::ostream & os, print_context ctx);
 }
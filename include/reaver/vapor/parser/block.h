@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "../range.h"
 #include "expression_list.h"
 #include "helpers.h"
@@ -32,18 +34,37 @@ namespace reaver::vapor::parser
 inline namespace _v1
 {
     struct statement;
+    class deferred_body;
 
     struct block
     {
         range_type range;
-        std::vector<variant<recursive_wrapper<block>, recursive_wrapper<statement>>> block_value;
+        node_vector<variant<recursive_wrapper<block>, recursive_wrapper<statement>>> block_value;
         optional<expression_list> value_expression;
+        // set if parsing the contents has been deferred; block_value and value_expression are empty then
+        std::shared_ptr<const deferred_body> deferred;
+
+        static void * operator new(std::size_t size)
+        {
+            return allocate_node(size);
+        }
+
+        static void operator delete(void * ptr)
+        {
+            deallocate_node(ptr);
+        }
     };
 
     bool operator==(const block & lhs, const block & rhs);
 
     block parse_block(context & ctx);
     block parse_single_statement_block(context & ctx);
+    // parses the body of a function or a lambda; defers parsing braced bodies if the context asks for that
+    block parse_function_body(context & ctx);
+
+    // returns the block itself, or, if parsing its contents has been deferred, the block they parse into
+    // the first call parses them, which is where errors inside of a deferred body are reported; safe to call from multiple threads
+    const block & parsed(const block & bl);
 
     void print(const expression_list & list, std::ostream & os, print_context ctx);
     void print(const block & bl, std::ostream & os, print_context ctx);
@@ -0,0 +1,59 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2014-2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <reaver/optional.h>
+
+#include "../source_file.h"
+#include "ast.h"
+
+namespace reaver::vapor::parser
+{
+inline namespace _v1
+{
+    // keeps serialized ASTs in a directory, named after a hash of the contents of the files they were parsed from, so that
+    // files that haven't changed since they were last parsed can be loaded without being lexed and parsed again
+    // every entry also holds the contents it was parsed from, and one whose contents differ from the file's is treated
+    // as missing, just like one that can't be loaded; entries are written to a temporary file first, and then
+    // renamed, so that concurrent compilations never see one half written
+    class ast_cache
+    {
+    public:
+        ast_cache(std::string directory);
+
+        optional<ast> load(const source_file & file) const;
+        void store(const source_file & file, const ast & tree) const;
+
+        // the path the entry for the file is stored under
+        std::string path(const source_file & file) const;
+
+    private:
+        std::string _directory;
+    };
+
+    // 64-bit FNV-1a of the contents of the file, in the encoding it is kept in
+    std::uint64_t content_hash(const source_file & file);
+}
+}
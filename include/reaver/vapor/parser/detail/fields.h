@@ -0,0 +1,172 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <tuple>
+
+#include "../ast.h"
+#include "../binary_expression.h"
+#include "../lambda_expression.h"
+#include "../unary_expression.h"
+
+namespace reaver::vapor::parser
+{
+inline namespace _v1
+{
+    namespace _detail
+    {
+        // the fields of every node, in the order they are declared in, for code that has to walk all of a tree
+        // generically, like serialization; the blocks are walked as they are, without looking through a deferred body
+        template<lexer::token_type TokenType>
+        auto fields(literal<TokenType> & node)
+        {
+            return std::tie(node.range, node.value, node.suffix);
+        }
+
+        inline auto fields(capture_list & node)
+        {
+            return std::tie(node.range);
+        }
+
+        inline auto fields(id_expression & node)
+        {
+            return std::tie(node.range, node.id_expression_value);
+        }
+
+        inline auto fields(member_expression & node)
+        {
+            return std::tie(node.range, node.member_name);
+        }
+
+        inline auto fields(import_expression & node)
+        {
+            return std::tie(node.range, node.module_name);
+        }
+
+        inline auto fields(expression & node)
+        {
+            return std::tie(node.range, node.expression_value);
+        }
+
+        inline auto fields(expression_list & node)
+        {
+            return std::tie(node.range, node.expressions);
+        }
+
+        inline auto fields(postfix_expression & node)
+        {
+            return std::tie(node.range, node.base_expression, node.modifier_type, node.arguments, node.accessed_member);
+        }
+
+        inline auto fields(unary_expression & node)
+        {
+            return std::tie(node.range, node.op, node.operand);
+        }
+
+        inline auto fields(binary_expression & node)
+        {
+            return std::tie(node.range, node.op, node.lhs, node.rhs);
+        }
+
+        inline auto fields(parameter & node)
+        {
+            return std::tie(node.range, node.name, node.type);
+        }
+
+        inline auto fields(parameter_list & node)
+        {
+            return std::tie(node.range, node.parameters);
+        }
+
+        inline auto fields(lambda_expression & node)
+        {
+            return std::tie(node.range, node.captures, node.parameters, node.return_type, node.body);
+        }
+
+        inline auto fields(struct_literal & node)
+        {
+            return std::tie(node.range, node.members);
+        }
+
+        inline auto fields(template_introducer & node)
+        {
+            return std::tie(node.range, node.template_parameters);
+        }
+
+        inline auto fields(template_expression & node)
+        {
+            return std::tie(node.range, node.parameters, node.expression);
+        }
+
+        inline auto fields(typeclass_literal & node)
+        {
+            return std::tie(node.range, node.members);
+        }
+
+        inline auto fields(instance_literal & node)
+        {
+            return std::tie(node.range, node.typeclass_name, node.arguments, node.definitions);
+        }
+
+        inline auto fields(default_instance_definition & node)
+        {
+            return std::tie(node.range, node.literal);
+        }
+
+        inline auto fields(declaration & node)
+        {
+            return std::tie(node.range, node.identifier, node.type_expression, node.rhs);
+        }
+
+        inline auto fields(return_expression & node)
+        {
+            return std::tie(node.range, node.return_value);
+        }
+
+        inline auto fields(function_declaration & node)
+        {
+            return std::tie(node.range, node.name, node.parameters, node.return_type);
+        }
+
+        inline auto fields(function_definition & node)
+        {
+            return std::tie(node.range, node.signature, node.body);
+        }
+
+        inline auto fields(block & node)
+        {
+            return std::tie(node.range, node.block_value, node.value_expression);
+        }
+
+        inline auto fields(if_statement & node)
+        {
+            return std::tie(node.range, node.condition, node.then_block, node.else_block);
+        }
+
+        inline auto fields(statement & node)
+        {
+            return std::tie(node.range, node.statement_value);
+        }
+    }
+}
+}
@@ -69,6 +69,8 @@ inline namespace _v1
 
     bool operator==(const expression & lhs, const expression & rhs);
 
+    // a single operand of a binary expression; a literal, a postfix expression, a unary expression...
+    expression parse_operand(context & ctx, expression_special_modes = expression_special_modes::none);
     expression parse_expression(context & ctx, expression_special_modes = expression_special_modes::none);
 
     void print(const expression & expr, std::ostream & os, print_context ctx);
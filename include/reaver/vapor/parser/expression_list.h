@@ -36,7 +36,17 @@ inline namespace _v1
     struct expression_list
     {
         range_type range;
-        std::vector<expression> expressions;
+        node_vector<expression> expressions;
+
+        static void * operator new(std::size_t size)
+        {
+            return allocate_node(size);
+        }
+
+        static void operator delete(void * ptr)
+        {
+            deallocate_node(ptr);
+        }
     };
 
     bool operator==(const expression_list & lhs, const expression_list & rhs);
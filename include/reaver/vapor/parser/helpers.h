@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <array>
 #include <type_traits>
 
 #include <reaver/exception.h>
@@ -31,6 +32,7 @@
 #include "../lexer/token.h"
 #include "../range.h"
 #include "../utf.h"
+#include "arena.h"
 
 namespace reaver::vapor::parser
 {
@@ -39,12 +41,12 @@ inline namespace _v1
     class expectation_failure : public exception
     {
     public:
-        expectation_failure(lexer::token_type expected, const std::u32string & actual, range_type & r) : exception{ logger::fatal }
+        expectation_failure(lexer::token_type expected, std::u32string_view actual, range_type & r) : exception{ logger::fatal }
         {
             *this << r << ": expected `" << lexer::token_types[+expected] << "`, got `" << utf8(actual) << "`";
         }
 
-        expectation_failure(const std::string & str, const std::u32string & actual, range_type & r) : exception{ logger::fatal }
+        expectation_failure(const std::string & str, std::u32string_view actual, range_type & r) : exception{ logger::fatal }
         {
             *this << r << ": expected " << str << ", got `" << utf8(actual) << "`";
         }
@@ -60,48 +62,145 @@ inline namespace _v1
         }
     };
 
-    enum class operator_type
+    enum class expression_special_modes
     {
-        unary,
-        binary
+        none,
+        assignment,
+        brace
     };
 
-    struct operator_context
+    enum class node_allocation
     {
-        lexer::token_type op;
-        operator_type type;
+        heap,
+        arena
     };
 
-    enum class expression_special_modes
+    enum class module_parsing
     {
-        none,
-        assignment,
-        brace
+        sequential,
+        // splits the body of a module into runs of statements on bracket-balanced boundaries, and parses the runs
+        // on the default executor
+        parallel
+    };
+
+    enum class body_parsing
+    {
+        eager,
+        // only finds where the bodies of functions and lambdas end; they are parsed when they are first needed, see parsed()
+        deferred
+    };
+
+    // the last tokens read off the lexer iterator of a context, in a ring of a fixed size
+    // they allow looking more than one token ahead, and going back to a checkpoint, without copying lexer iterators, which
+    // would touch their reference counts on every step; see peek(ctx, n), mark() and rewind()
+    class lookahead_buffer
+    {
+    public:
+        static constexpr std::size_t capacity = 16;
+
+        // the number of tokens consumed by the parser so far
+        std::size_t position() const
+        {
+            return _position;
+        }
+
+        // the number of tokens read that the parser hasn't consumed yet
+        std::size_t ahead() const
+        {
+            return _read - _position;
+        }
+
+        // only valid for n < ahead()
+        lexer::token & peek(std::size_t n)
+        {
+            return _tokens[(_position + n) % capacity];
+        }
+
+        void push(const lexer::token & tok)
+        {
+            if (ahead() == capacity)
+            {
+                throw exception(logger::crash) << "the lookahead buffer is full";
+            }
+
+            _tokens[_read++ % capacity] = tok;
+        }
+
+        void consume()
+        {
+            ++_position;
+        }
+
+        // the tokens consumed since `position` must all still be in the buffer
+        void rewind(std::size_t position)
+        {
+            if (position > _position || _read - position > capacity)
+            {
+                throw exception(logger::crash) << "can't rewind to token " << position << ", the lookahead buffer holds tokens from "
+                                               << (_read > capacity ? _read - capacity : 0) << " to " << _position;
+            }
+
+            _position = position;
+        }
+
+    private:
+        std::array<lexer::token, capacity> _tokens;
+        std::size_t _read = 0;
+        std::size_t _position = 0;
     };
 
     struct context
     {
+        // the next token that hasn't been read into the lookahead buffer yet; that's also the current token, unless there are
+        // tokens read ahead, so code that walks these iterators itself has to check that there are none first, and can't be
+        // rewound over
         lexer::iterator begin, end;
-        std::vector<operator_context> operator_stack;
+        // the precedence of the innermost operator whose operand is being parsed; none inside of brackets
+        optional<std::size_t> enclosing_precedence;
+        node_allocation allocation = node_allocation::arena;
+        module_parsing parsing = module_parsing::sequential;
+        body_parsing bodies = body_parsing::eager;
+        lookahead_buffer lookahead = {};
     };
 
-    inline lexer::token expect(context & ctx, lexer::token_type expected)
+    // reads tokens into the lookahead buffer until there's `count` of them ahead, or the end of the stream; returns how
+    // many there are
+    inline std::size_t read_ahead(context & ctx, std::size_t count)
     {
-        if (ctx.begin->type != expected)
+        while (ctx.lookahead.ahead() < count && ctx.begin != ctx.end)
         {
-            throw expectation_failure{ expected, ctx.begin->string, ctx.begin->range };
+            ctx.lookahead.push(*ctx.begin);
+            ++ctx.begin;
         }
 
-        if (ctx.begin == ctx.end)
+        return ctx.lookahead.ahead();
+    }
+
+    inline lexer::token expect(context & ctx, lexer::token_type expected)
+    {
+        if (!read_ahead(ctx, 1))
         {
             throw expectation_failure{ expected };
         }
 
-        return std::move(*ctx.begin++);
+        auto & tok = ctx.lookahead.peek(0);
+        if (tok.type != expected)
+        {
+            throw expectation_failure{ expected, tok.string, tok.range };
+        }
+
+        // the token stays in the buffer, for rewind()
+        ctx.lookahead.consume();
+        return tok;
     }
 
     inline optional<lexer::token &> peek(context & ctx)
     {
+        if (ctx.lookahead.ahead())
+        {
+            return { ctx.lookahead.peek(0) };
+        }
+
         if (ctx.begin != ctx.end)
         {
             return { *ctx.begin };
@@ -112,12 +211,51 @@ inline namespace _v1
 
     inline optional<lexer::token &> peek(context & ctx, lexer::token_type expected)
     {
-        if (ctx.begin != ctx.end && ctx.begin->type == expected)
+        auto tok = peek(ctx);
+        if (tok && tok->type == expected)
         {
-            return { *ctx.begin };
+            return tok;
         }
 
         return {};
     };
+
+    // the token `n` tokens after the current one; up to lookahead_buffer::capacity - 1 tokens ahead
+    inline optional<lexer::token &> peek(context & ctx, std::size_t n)
+    {
+        if (n >= lookahead_buffer::capacity)
+        {
+            throw exception(logger::crash) << "can't look " << n << " tokens ahead, the lookahead buffer only holds " << lookahead_buffer::capacity;
+        }
+
+        if (n == 0)
+        {
+            return peek(ctx);
+        }
+
+        if (read_ahead(ctx, n + 1) <= n)
+        {
+            return {};
+        }
+
+        return { ctx.lookahead.peek(n) };
+    }
+
+    // a point in the token stream of a context to go back to, for parsing something speculatively; a checkpoint is just
+    // a number, and is valid for as long as the tokens consumed since it was made still fit in the lookahead buffer
+    struct checkpoint
+    {
+        std::size_t position;
+    };
+
+    inline checkpoint mark(const context & ctx)
+    {
+        return { ctx.lookahead.position() };
+    }
+
+    inline void rewind(context & ctx, checkpoint point)
+    {
+        ctx.lookahead.rewind(point.position);
+    }
 }
 }
@@ -0,0 +1,44 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <string>
+
+#include "../lexer/incremental.h"
+#include "../source_file.h"
+#include "module.h"
+
+namespace reaver::vapor::parser
+{
+inline namespace _v1
+{
+    // updates `previous`, parsed from a text before `edit`, to match `text`, the same text after `edit`; the result
+    // compares equal to parsing `text` from scratch
+    // the statements that end before the edit, save for the last one of them, which the parser could have looked past,
+    // are copied as they are; the ones after the edit are copied, with their positions moved, from the first one that
+    // the statements parsed again line up with; only the ones in between are lexed and parsed again
+    // the result is allocated from an arena of its own, so `previous` can be destroyed right after
+    // `edit` must not start before the module does; errors are reported like from parse_module
+    module reparse(const module & previous, const std::u32string & text, const lexer::text_edit & edit, file_id file = unknown_file);
+}
+}
@@ -41,6 +41,16 @@ inline namespace _v1
         optional<parameter_list> parameters;
         optional<expression> return_type;
         block body;
+
+        static void * operator new(std::size_t size)
+        {
+            return allocate_node(size);
+        }
+
+        static void operator delete(void * ptr)
+        {
+            deallocate_node(ptr);
+        }
     };
 
     bool operator==(const lambda_expression & lhs, const lambda_expression & rhs);
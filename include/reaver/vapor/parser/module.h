@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "../range.h"
 #include "helpers.h"
@@ -35,9 +37,14 @@ inline namespace _v1
 {
     struct module
     {
+        // declared first, so that it outlives the nodes allocated from it
+        std::shared_ptr<arena> memory;
+        // the arenas of the statements that were parsed in parallel, one for every run of statements
+        std::vector<std::shared_ptr<arena>> statement_memory;
+
         range_type range;
         id_expression name;
-        std::vector<statement> statements;
+        node_vector<statement> statements;
     };
 
     module parse_module(context & ctx);
@@ -39,7 +39,7 @@ inline namespace _v1
         range_type range;
         variant<identifier, recursive_wrapper<expression_list>> base_expression = identifier();
         optional<lexer::token_type> modifier_type = none;
-        std::vector<expression> arguments = {};
+        node_vector<expression> arguments = {};
         optional<identifier> accessed_member = none;
     };
 
@@ -0,0 +1,53 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2014-2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <reaver/exception.h>
+
+#include "../source_file.h"
+#include "ast.h"
+
+namespace reaver::vapor::parser
+{
+inline namespace _v1
+{
+    class invalid_serialized_ast : public exception
+    {
+    public:
+        invalid_serialized_ast(const std::string & reason) : exception{ logger::error }
+        {
+            *this << "invalid serialized AST: " << reason;
+        }
+    };
+
+    // a compact binary form of an AST, which can be loaded back without lexing the source again
+    // all numbers are LEB128 varints; every distinct token string is stored once, in a table in front of the nodes, and
+    // loading reads each of them once, into a table the loaded tree keeps alive; identifiers are interned, and the tokens
+    // of everything else refer to the table, so no string is built per token
+    // the files of positions are not stored; all the positions of a loaded AST refer to `file`
+    std::string serialize(const ast & tree);
+    ast deserialize(std::string_view data, file_id file = unknown_file);
+}
+}
@@ -45,6 +45,16 @@ inline namespace _v1
         range_type range;
         variant<declaration, default_instance_definition, return_expression, expression_list, function_definition, if_statement> statement_value =
             expression_list();
+
+        static void * operator new(std::size_t size)
+        {
+            return allocate_node(size);
+        }
+
+        static void operator delete(void * ptr)
+        {
+            deallocate_node(ptr);
+        }
     };
 
     bool operator==(const statement & lhs, const statement & rhs);
@@ -34,7 +34,17 @@ inline namespace _v1
     struct struct_literal
     {
         range_type range;
-        std::vector<variant<declaration, function_definition>> members;
+        node_vector<variant<declaration, function_definition>> members;
+
+        static void * operator new(std::size_t size)
+        {
+            return allocate_node(size);
+        }
+
+        static void operator delete(void * ptr)
+        {
+            deallocate_node(ptr);
+        }
     };
 
     bool operator==(const struct_literal & lhs, const struct_literal & rhs);
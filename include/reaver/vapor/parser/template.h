@@ -42,6 +42,16 @@ inline namespace _v1
         range_type range;
         template_introducer parameters;
         variant<typeclass_literal> expression = typeclass_literal{};
+
+        static void * operator new(std::size_t size)
+        {
+            return allocate_node(size);
+        }
+
+        static void operator delete(void * ptr)
+        {
+            deallocate_node(ptr);
+        }
     };
 
     bool operator==(const template_introducer & lhs, const template_introducer & rhs);
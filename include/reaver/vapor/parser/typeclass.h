@@ -34,7 +34,7 @@ inline namespace _v1
     struct typeclass_literal
     {
         range_type range;
-        std::vector<variant<function_declaration, function_definition>> members;
+        node_vector<variant<function_declaration, function_definition>> members;
     };
 
     struct typeclass_definition
@@ -48,7 +48,17 @@ inline namespace _v1
         range_type range;
         id_expression typeclass_name;
         expression_list arguments;
-        std::vector<function_definition> definitions;
+        node_vector<function_definition> definitions;
+
+        static void * operator new(std::size_t size)
+        {
+            return allocate_node(size);
+        }
+
+        static void operator delete(void * ptr)
+        {
+            deallocate_node(ptr);
+        }
     };
 
     struct default_instance_definition
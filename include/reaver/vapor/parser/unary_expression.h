@@ -44,6 +44,16 @@ inline namespace _v1
         range_type range;
         lexer::token op;
         expression operand;
+
+        static void * operator new(std::size_t size)
+        {
+            return allocate_node(size);
+        }
+
+        static void operator delete(void * ptr)
+        {
+            deallocate_node(ptr);
+        }
     };
 
     inline bool operator==(const unary_expression & lhs, const unary_expression & rhs)
@@ -53,6 +63,9 @@ inline namespace _v1
 
     const std::vector<lexer::token_type> & unary_operators();
 
+    // binds tighter than all binary operators, except for indirection
+    constexpr std::size_t unary_operator_precedence = 5;
+
     inline bool is_unary_operator(lexer::token_type t)
     {
         return std::find(unary_operators().begin(), unary_operators().end(), t) != unary_operators().end();
@@ -22,12 +22,16 @@
 
 #pragma once
 
-#include <string>
+#include <cstdint>
+#include <ostream>
+
+#include "source_file.h"
 
 namespace reaver::vapor
 {
 inline namespace _v1
 {
+    // 8 bytes; the line and the column are only computed when asked for, using the file table
     struct position
     {
         position()
@@ -38,7 +42,7 @@ inline namespace _v1
         position & operator=(const position &) = default;
         position & operator=(position &&) = default;
 
-        position(std::size_t offset) : offset{ offset }
+        position(std::uint32_t offset, file_id file = unknown_file) : offset{ offset }, file{ file }
         {
         }
 
@@ -51,7 +55,6 @@ inline namespace _v1
         position & operator+=(std::size_t len)
         {
             offset += len;
-            column += len;
             return *this;
         }
 
@@ -62,10 +65,19 @@ inline namespace _v1
             return ret;
         }
 
-        std::size_t offset = 0;
-        std::size_t line = 1;
-        std::size_t column = 1;
-        std::string file;
+        bool has_location() const
+        {
+            return file != unknown_file;
+        }
+
+        // only valid if has_location()
+        line_column location() const
+        {
+            return get_source_file(file).locate(offset);
+        }
+
+        std::uint32_t offset = 0;
+        file_id file = unknown_file;
     };
 
     inline bool operator!=(const position & lhs, const position & rhs)
@@ -77,5 +89,16 @@ inline namespace _v1
     {
         return !(lhs != rhs);
     }
+
+    inline std::ostream & operator<<(std::ostream & os, const position & p)
+    {
+        if (!p.has_location())
+        {
+            return os << "(" << p.offset << ")";
+        }
+
+        auto location = p.location();
+        return os << location.line << ":" << location.column << " (" << p.offset << ")";
+    }
 }
 }
@@ -66,13 +66,17 @@ inline namespace _v1
 
     inline std::ostream & operator<<(std::ostream & os, const range_type & r)
     {
+        if (r.start().has_location())
+        {
+            os << get_source_file(r.start().file).name() << ":";
+        }
+
         if (r.end() - r.start() > 1)
         {
-            return os << r.start().line << ":" << r.start().column << " (" << r.start().offset << ") - " << r.end().line << ":" << r.end().column << " ("
-                      << r.end().offset << ")";
+            return os << r.start() << " - " << r.end();
         }
 
-        return os << r.start().line << ":" << r.start().column << " (" << r.start().offset << ")";
+        return os << r.start();
     }
 }
 }
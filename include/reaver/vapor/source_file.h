@@ -0,0 +1,120 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "mapped_file.h"
+#include "utf8_iterator.h"
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    using file_id = std::uint32_t;
+
+    // the file of positions in sources that were never registered, like the ones built in memory by tests
+    constexpr file_id unknown_file = 0;
+
+    struct line_column
+    {
+        std::size_t line;
+        std::size_t column;
+    };
+
+    class source_file
+    {
+    public:
+        source_file(file_id id, std::string name, std::u32string contents) : _id{ id }, _name{ std::move(name) }, _contents{ std::move(contents) }
+        {
+        }
+
+        source_file(file_id id, std::string name, mapped_file utf8_contents) : _id{ id }, _name{ std::move(name) }, _mapping{ std::move(utf8_contents) }, _is_utf8{ true }
+        {
+        }
+
+        source_file(const source_file &) = delete;
+        source_file & operator=(const source_file &) = delete;
+
+        file_id id() const
+        {
+            return _id;
+        }
+
+        const std::string & name() const
+        {
+            return _name;
+        }
+
+        // files opened with open_source_file are kept in UTF-8 and decoded while lexing
+        bool is_utf8() const
+        {
+            return _is_utf8;
+        }
+
+        // only valid if !is_utf8()
+        const std::u32string & contents() const
+        {
+            return _contents;
+        }
+
+        // only valid if is_utf8()
+        std::string_view utf8_contents() const
+        {
+            return _mapping.view();
+        }
+
+        utf8_iterator utf8_begin() const
+        {
+            return { _mapping.data(), _mapping.data() + _mapping.size() };
+        }
+
+        utf8_iterator utf8_end() const
+        {
+            return { _mapping.data() + _mapping.size(), _mapping.data() + _mapping.size() };
+        }
+
+        // both 1-based, counted in code points; the line-start index is built on the first call
+        line_column locate(std::uint32_t offset) const;
+
+    private:
+        file_id _id;
+        std::string _name;
+        std::u32string _contents;
+        mapped_file _mapping;
+        bool _is_utf8 = false;
+
+        mutable std::once_flag _index_built;
+        mutable std::vector<std::uint32_t> _line_starts;
+    };
+
+    // registered files live until the end of the program; all of these are safe to call from multiple threads
+    const source_file & register_source_file(std::string name, std::u32string contents);
+    // maps the file at `path` into memory; throws if that fails
+    const source_file & open_source_file(const std::string & path);
+    const source_file & get_source_file(file_id id);
+}
+}
@@ -0,0 +1,110 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    // the cost of a single phase of compilation
+    struct phase_cost
+    {
+        std::string name;
+        // how many phases this one is nested in
+        std::size_t depth = 0;
+        double wall_seconds = 0;
+        // of the whole process, so it includes the work of the threads of the executor
+        double cpu_seconds = 0;
+        // how much the peak resident set size of the process grew, in kilobytes
+        long peak_rss_growth = 0;
+        std::size_t allocations = 0;
+    };
+
+    // the costs of the phases of a compilation, in the spirit of -ftime-report; see phase_timer
+    // the phases are listed in the order they were started in, and nest in each other by that order, so they should be
+    // started and finished on a single thread
+    class time_report
+    {
+    public:
+        // `allocation_counter` returns the number of allocations the process has made so far; without it, the allocation
+        // counts are all zero
+        time_report(std::function<std::size_t()> allocation_counter = {}) : _allocation_counter{ std::move(allocation_counter) }
+        {
+        }
+
+        std::vector<phase_cost> phases() const;
+
+        void print_table(std::ostream & os) const;
+        void print_json(std::ostream & os) const;
+
+    private:
+        friend class phase_timer;
+
+        struct _snapshot
+        {
+            std::chrono::steady_clock::time_point wall;
+            double cpu_seconds;
+            long peak_rss;
+            std::size_t allocations;
+        };
+
+        _snapshot _take_snapshot() const;
+        std::size_t _start(std::string name);
+        void _finish(std::size_t index, const _snapshot & start);
+
+        std::function<std::size_t()> _allocation_counter;
+
+        mutable std::mutex _lock;
+        std::vector<phase_cost> _phases;
+        std::size_t _depth = 0;
+    };
+
+    // the report that phase timers add to; there is none by default
+    time_report * active_time_report();
+    void set_active_time_report(time_report * report);
+
+    // measures a phase, from its construction to its destruction, into the active time report, if there is one
+    class phase_timer
+    {
+    public:
+        phase_timer(std::string name);
+        ~phase_timer();
+
+        phase_timer(const phase_timer &) = delete;
+        phase_timer & operator=(const phase_timer &) = delete;
+
+    private:
+        time_report * _report;
+        std::size_t _index = 0;
+        time_report::_snapshot _start = {};
+    };
+}
+}
@@ -0,0 +1,105 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#include <reaver/optional.h>
+
+#include "range.h"
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    // a span of work on a single node, from the moment it was started until the future it produced became ready
+    struct trace_span
+    {
+        // what was being done to the node, like "analyze" or "simplify"
+        const char * name;
+        // the dynamic type of the node
+        const std::type_info * kind;
+        optional<range_type> range;
+
+        std::chrono::steady_clock::time_point begin;
+        std::chrono::steady_clock::time_point end;
+        std::thread::id begin_thread;
+        std::thread::id end_thread;
+        bool finished = false;
+    };
+
+    // collects trace spans and writes them out in the Chrome trace event format, which both chrome://tracing and Perfetto
+    // load; see trace_event
+    // the work on a node usually starts and finishes on different threads, so every span is written as a pair of async
+    // events, which can cross threads, rather than as a duration event
+    class trace_recorder
+    {
+    public:
+        std::vector<trace_span> spans() const;
+
+        void print_json(std::ostream & os) const;
+
+    private:
+        friend class trace_event;
+
+        std::size_t _begin(const char * name, const std::type_info & kind, optional<range_type> range);
+        void _end(std::size_t index);
+
+        const std::chrono::steady_clock::time_point _start = std::chrono::steady_clock::now();
+
+        mutable std::mutex _lock;
+        std::vector<trace_span> _spans;
+    };
+
+    // the recorder that trace events go to; there is none by default
+    trace_recorder * active_trace_recorder();
+    void set_active_trace_recorder(trace_recorder * recorder);
+
+    // a handle to a span in the active trace recorder; it is begun on construction and ended with finish(), which is
+    // meant to be called from a continuation of the traced future
+    // when there is no active recorder, neither of those does anything
+    class trace_event
+    {
+    public:
+        trace_event(const char * name, const std::type_info & kind, optional<range_type> range = none);
+
+        bool active() const
+        {
+            return _recorder;
+        }
+
+        void finish() const;
+
+    private:
+        trace_recorder * _recorder;
+        std::size_t _index = 0;
+    };
+}
+}
@@ -30,6 +30,7 @@
 namespace std
 {
 using experimental::string_view;
+using experimental::u32string_view;
 }
 #endif
 
@@ -46,6 +47,11 @@ inline namespace _v1
         return boost::locale::conv::utf_to_utf<char>(utf32);
     }
 
+    inline auto utf8(std::u32string_view utf32)
+    {
+        return boost::locale::conv::utf_to_utf<char>(utf32.data(), utf32.data() + utf32.size());
+    }
+
     inline auto utf32(const std::string & utf8)
     {
         return boost::locale::conv::utf_to_utf<char32_t>(utf8);
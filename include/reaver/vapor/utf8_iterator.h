@@ -0,0 +1,150 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    // decodes UTF-8 on the fly, so that a file can be lexed without converting it to UTF-32 first
+    // ASCII is decoded with a single comparison; malformed sequences decode to U+FFFD, one byte at a time
+    class utf8_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = char32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char32_t *;
+        using reference = char32_t;
+
+        utf8_iterator() = default;
+
+        utf8_iterator(const char * ptr, const char * end) : _ptr{ ptr }, _end{ end }
+        {
+        }
+
+        char32_t operator*() const
+        {
+            auto lead = static_cast<unsigned char>(*_ptr);
+            if (lead < 0x80)
+            {
+                return lead;
+            }
+
+            return _decode().first;
+        }
+
+        utf8_iterator & operator++()
+        {
+            if (static_cast<unsigned char>(*_ptr) < 0x80)
+            {
+                ++_ptr;
+            }
+
+            else
+            {
+                _ptr += _decode().second;
+            }
+
+            return *this;
+        }
+
+        utf8_iterator operator++(int)
+        {
+            auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        bool operator==(const utf8_iterator & other) const
+        {
+            return _ptr == other._ptr;
+        }
+
+        bool operator!=(const utf8_iterator & other) const
+        {
+            return _ptr != other._ptr;
+        }
+
+        const char * base() const
+        {
+            return _ptr;
+        }
+
+    private:
+        // returns the code point and the length of its encoding
+        std::pair<char32_t, std::size_t> _decode() const
+        {
+            constexpr std::pair<char32_t, std::size_t> invalid = { U'\uFFFD', 1 };
+
+            auto byte = [&](std::size_t i) { return static_cast<unsigned char>(_ptr[i]); };
+            auto is_continuation = [&](std::size_t i) { return (byte(i) & 0xC0) == 0x80; };
+
+            auto lead = byte(0);
+            std::size_t length = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : 2;
+
+            if (lead < 0xC2 || lead > 0xF4 || static_cast<std::size_t>(_end - _ptr) < length)
+            {
+                return invalid;
+            }
+
+            for (std::size_t i = 1; i < length; ++i)
+            {
+                if (!is_continuation(i))
+                {
+                    return invalid;
+                }
+            }
+
+            switch (length)
+            {
+                case 2:
+                    return { (char32_t(lead & 0x1F) << 6) | (byte(1) & 0x3F), 2 };
+
+                case 3:
+                    // overlong encodings and surrogates
+                    if ((lead == 0xE0 && byte(1) < 0xA0) || (lead == 0xED && byte(1) >= 0xA0))
+                    {
+                        return invalid;
+                    }
+                    return { (char32_t(lead & 0x0F) << 12) | (char32_t(byte(1) & 0x3F) << 6) | (byte(2) & 0x3F), 3 };
+
+                default:
+                    // overlong encodings and code points past U+10FFFF
+                    if ((lead == 0xF0 && byte(1) < 0x90) || (lead == 0xF4 && byte(1) >= 0x90))
+                    {
+                        return invalid;
+                    }
+                    return { (char32_t(lead & 0x07) << 18) | (char32_t(byte(1) & 0x3F) << 12) | (char32_t(byte(2) & 0x3F) << 6) | (byte(3) & 0x3F), 4 };
+            }
+        }
+
+        const char * _ptr = nullptr;
+        const char * _end = nullptr;
+    };
+}
+}
@@ -0,0 +1,96 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <reaver/future.h>
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    // an executor for lots of small tasks that mostly push more small tasks, like the continuations of the analyzer
+    // every worker has its own deque of tasks; the tasks pushed from a worker go to the back of its deque, and it takes them
+    // back from there, last in first out, so it keeps working on the subtree it has just started, while the tasks pushed
+    // from other threads go to a shared queue
+    // a worker with nothing left to do takes a task from the shared queue, and then steals the oldest task of another
+    // worker, which is usually the root of the biggest piece of work that worker has queued
+    class work_stealing_executor : public executor
+    {
+    public:
+        struct statistics
+        {
+            // tasks pushed by the workers themselves, to their own deques
+            std::size_t pushed_locally = 0;
+            // tasks pushed by other threads, to the shared queue
+            std::size_t pushed_externally = 0;
+            // tasks a worker took from the deque of another worker
+            std::size_t stolen = 0;
+        };
+
+        work_stealing_executor(std::size_t threads);
+        // finishes the tasks that are still queued; this must not be called from one of the workers
+        ~work_stealing_executor();
+
+        virtual void push(function<void()> f) override;
+
+        statistics get_statistics() const;
+
+    private:
+        struct _worker
+        {
+            std::mutex lock;
+            std::deque<function<void()>> tasks;
+        };
+
+        bool _try_pop(std::size_t index, function<void()> & task);
+        void _run(std::size_t index);
+
+        std::vector<std::unique_ptr<_worker>> _workers;
+
+        std::mutex _shared_lock;
+        std::deque<function<void()>> _shared_tasks;
+
+        // the tasks that were pushed, but that no worker has taken yet
+        std::atomic<std::size_t> _pending{ 0 };
+        std::atomic<std::size_t> _sleeping{ 0 };
+        std::mutex _sleep_lock;
+        std::condition_variable _wake;
+        bool _stop = false;
+
+        std::atomic<std::size_t> _pushed_locally{ 0 };
+        std::atomic<std::size_t> _pushed_externally{ 0 };
+        std::atomic<std::size_t> _stolen{ 0 };
+
+        std::vector<std::thread> _threads;
+    };
+}
+}
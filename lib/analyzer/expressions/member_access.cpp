@@ -30,7 +30,7 @@ inline namespace _v1
 {
     std::unique_ptr<member_access_expression> preanalyze_member_access_expression(const parser::member_expression & parse, scope *)
     {
-        return std::make_unique<member_access_expression>(make_node(parse), parse.member_name.value.string);
+        return std::make_unique<member_access_expression>(make_node(parse), parse.member_name.value.id);
     }
 
     void member_access_expression::print(std::ostream & os, print_context ctx) const
@@ -44,7 +44,7 @@ inline namespace _v1
         {
             os << styles::def << " @ " << styles::address << this << styles::def << ": ";
         }
-        os << styles::string_value << ' ' << utf8(_name) << '\n';
+        os << styles::string_value << ' ' << utf8(_name.string()) << '\n';
 
         auto type_ctx = ctx.make_branch(true);
         os << styles::def << type_ctx << styles::subrule_name << "referenced member type:\n";
@@ -61,7 +61,7 @@ inline namespace _v1
         auto retvar = codegen::ir::make_variable(_base->get_type()->get_member_type(_name)->codegen_type(ctx));
 
         return { codegen::ir::instruction{
-            none, none, { boost::typeindex::type_id<codegen::ir::member_access_instruction>() }, { base_variable, codegen::ir::label{ _name, {} } }, retvar } };
+            none, none, { boost::typeindex::type_id<codegen::ir::member_access_instruction>() }, { base_variable, codegen::ir::label{ _name.str(), {} } }, retvar } };
     }
 
     bool member_access_expression::_invalidate_ir(ir_generation_context & ctx) const
@@ -41,14 +41,14 @@ inline namespace _v1
                     [&](const parser::identifier & ident) { return preanalyze_identifier(ident, lex_scope); }))),
             parse.modifier_type,
             fmap(parse.arguments, [&](auto && expr) { return preanalyze_expression(expr, lex_scope); }),
-            fmap(parse.accessed_member, [&](auto && member) { return member.value.string; }));
+            fmap(parse.accessed_member, [&](auto && member) { return member.value.id; }));
     }
 
     postfix_expression::postfix_expression(ast_node parse,
         std::unique_ptr<expression> base,
         optional<lexer::token_type> mod,
         std::vector<std::unique_ptr<expression>> arguments,
-        optional<std::u32string> accessed_member)
+        optional<identifier_id> accessed_member)
         : _base_expr{ std::move(base) }, _modifier{ mod }, _arguments{ std::move(arguments) }, _accessed_member{ std::move(accessed_member) }
     {
         _set_ast_info(parse);
@@ -73,7 +73,7 @@ inline namespace _v1
             if (_modifier == lexer::token_type::dot)
             {
                 auto referenced_ctx = ctx.make_branch(true);
-                os << styles::def << referenced_ctx << styles::subrule_name << "referenced member: " << styles::string_value << utf8(*_accessed_member) << '\n';
+                os << styles::def << referenced_ctx << styles::subrule_name << "referenced member: " << styles::string_value << utf8(_accessed_member->string()) << '\n';
                 return;
             }
 
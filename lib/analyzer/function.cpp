@@ -24,6 +24,7 @@
 #include "vapor/analyzer/statements/block.h"
 #include "vapor/analyzer/statements/return.h"
 #include "vapor/analyzer/symbol.h"
+#include "vapor/analyzer/trace.h"
 #include "vapor/parser/expression_list.h"
 #include "vapor/parser/lambda_expression.h"
 
@@ -35,7 +36,8 @@ inline namespace _v1
     {
         if (_body)
         {
-            return _body->simplify(ctx).then([&](auto && simplified) { _body = dynamic_cast<block *>(simplified); });
+            return traced(trace_event{ "simplify", typeid(*this), _range },
+                [&] { return _body->simplify(ctx).then([&](auto && simplified) { _body = dynamic_cast<block *>(simplified); }); });
         }
 
         return make_ready_future();
@@ -45,6 +47,9 @@ inline namespace _v1
     {
         if (_body)
         {
+            // a call is folded from the body as it is now, so whatever is replaced in it later has to be folded again
+            ctx.used(_body);
+
             auto new_frame = call_frame{ this, arguments };
 
             if (auto expr = ctx.proper.results.get_call_result(new_frame))
@@ -57,64 +62,66 @@ inline namespace _v1
                 return make_ready_future<expression *>(nullptr);
             }
 
-            return [&] {
-                if (arguments.size())
-                {
-                    auto body = _body->clone_with_replacement(_parameters, arguments);
-                    auto proper_ctx = std::make_shared<simplification_context>(ctx.proper.results);
-
-                    auto simplify = [this, arguments, proper_ctx, ctx = recursive_context{ *proper_ctx, ctx.call_stack }](auto self, auto body)
+            return traced(trace_event{ "simplify call", typeid(*this), _range }, [&] {
+                return [&] {
+                    if (arguments.size())
                     {
-                        auto new_ctx = ctx;
-                        new_ctx.call_stack.push_back({ this, arguments });
-                        return body->simplify(new_ctx).then([proper_ctx, old_body = body, new_ctx, self](auto && body)->future<statement *> {
-                            if (!new_ctx.proper.did_something_happen())
-                            {
-                                return make_ready_future(body);
-                            }
-
-                            // ugh
-                            // but I don't know how else to write this
-                            // without creating a long overload for optctx
-                            auto & res = proper_ctx->results;
-                            proper_ctx->~simplification_context();
-                            new (&*proper_ctx) simplification_context(res);
-                            return self(self, body);
-                        });
-                    };
-
-                    // this is a leak
-                    return simplify(simplify, body.release());
-                }
-
-                assert(_body);
-                return make_ready_future<statement *>(_body);
-            }()
-                       .then([=](auto && body) {
-                           auto returns = body->get_returns();
-
-                           auto body_block = dynamic_cast<block *>(body);
-                           auto has_return_expr = body_block && body_block->has_return_expression();
-                           assert(has_return_expr || returns.size());
-
-                           auto expr = has_return_expr ? body_block->get_return_expression() : returns.front()->get_returned_expression();
-                           auto begin = has_return_expr ? returns.begin() : returns.begin() + 1;
-
-                           if (!expr->is_constant())
-                           {
+                        auto body = _body->clone_with_replacement(_parameters, arguments);
+                        auto proper_ctx = std::make_shared<simplification_context>(ctx.proper.results);
+
+                        auto simplify = [this, arguments, proper_ctx, ctx = recursive_context{ *proper_ctx, ctx.call_stack }](auto self, auto body)
+                        {
+                            auto new_ctx = ctx;
+                            new_ctx.call_stack.push_back({ this, arguments });
+                            return body->simplify(new_ctx).then([proper_ctx, old_body = body, new_ctx, self](auto && body)->future<statement *> {
+                                if (!new_ctx.proper.did_something_happen())
+                                {
+                                    return make_ready_future(body);
+                                }
+
+                                // ugh
+                                // but I don't know how else to write this
+                                // without creating a long overload for optctx
+                                auto & res = proper_ctx->results;
+                                proper_ctx->~simplification_context();
+                                new (&*proper_ctx) simplification_context(res);
+                                return self(self, body);
+                            });
+                        };
+
+                        // this is a leak
+                        return simplify(simplify, body.release());
+                    }
+
+                    assert(_body);
+                    return make_ready_future<statement *>(_body);
+                }()
+                           .then([=](auto && body) {
+                               auto returns = body->get_returns();
+
+                               auto body_block = dynamic_cast<block *>(body);
+                               auto has_return_expr = body_block && body_block->has_return_expression();
+                               assert(has_return_expr || returns.size());
+
+                               auto expr = has_return_expr ? body_block->get_return_expression() : returns.front()->get_returned_expression();
+                               auto begin = has_return_expr ? returns.begin() : returns.begin() + 1;
+
+                               if (!expr->is_constant())
+                               {
+                                   return make_ready_future<expression *>(nullptr);
+                               }
+
+                               if (std::all_of(begin, returns.end(), [](auto && ret) { return ret->get_returned_expression()->is_constant(); })
+                                   && std::all_of(begin, returns.end(), [&](auto && ret) { return ret->get_returned_expression()->is_equal(expr); }))
+                               {
+                                   replacements a, b;
+                                   ctx.proper.results.save_call_result(call_frame{ this, arguments }, a.claim(expr));
+                                   return make_ready_future(b.claim(expr).release());
+                               }
+
                                return make_ready_future<expression *>(nullptr);
-                           }
-
-                           if (std::all_of(begin, returns.end(), [](auto && ret) { return ret->get_returned_expression()->is_constant(); })
-                               && std::all_of(begin, returns.end(), [&](auto && ret) { return ret->get_returned_expression()->is_equal(expr); }))
-                           {
-                               replacements a, b;
-                               ctx.proper.results.save_call_result(call_frame{ this, arguments }, a.claim(expr));
-                               return make_ready_future(b.claim(expr).release());
-                           }
-
-                           return make_ready_future<expression *>(nullptr);
-                       });
+                           });
+            });
         }
 
         if (_compile_time_eval)
@@ -20,12 +20,16 @@
  *
  **/
 
+#include <numeric>
+#include <unordered_map>
+
 #include <reaver/future_get.h>
 #include <reaver/prelude/monad.h>
 #include <reaver/traits.h>
 
 #include "vapor/analyzer/module.h"
 #include "vapor/parser.h"
+#include "vapor/time_report.h"
 
 namespace reaver::vapor::analyzer
 {
@@ -50,6 +54,8 @@ inline namespace _v1
 
     void module::analyze(analysis_context & ctx)
     {
+        phase_timer timer{ "module " + utf8(name()) };
+
         _analysis_futures = fmap(_statements, [&](auto && stmt) { return stmt->analyze(ctx); });
 
         auto all = when_all(_analysis_futures);
@@ -65,7 +71,7 @@ inline namespace _v1
             // maybe this can be relaxed in the future?
             assert(overloads.size() == 1);
             assert(overloads[0]->parameters().size() == 1);
-            assert(overloads[0]->parameters()[0]->get_type() == ctx.sized_integers.at(32).get());
+            assert(overloads[0]->parameters()[0]->get_type() == ctx.get_sized_integer_type(32));
 
             overloads[0]->mark_as_entry(ctx, entry.get()->get_expression());
         }
@@ -73,28 +79,53 @@ inline namespace _v1
         logger::dlog() << "Analysis of module " << utf8(name()) << " finished.";
     }
 
-    void module::simplify()
+    void module::simplify(simplification_reruns reruns)
     {
-        bool cont = true;
+        phase_timer timer{ "module " + utf8(name()) };
+
         cached_results res;
-        while (cont)
+        dependency_graph dependencies;
+
+        // every statement is simplified at first; after that, only the ones that use a node something was replaced in
+        std::vector<std::size_t> worklist(_statements.size());
+        std::iota(worklist.begin(), worklist.end(), 0);
+
+        for (std::size_t iteration = 1; !worklist.empty(); ++iteration)
         {
-            logger::dlog() << "Simplification run of module " << utf8(name()) << " starting...";
+            logger::dlog() << "Simplification run of module " << utf8(name()) << " starting, with " << worklist.size() << " of " << _statements.size()
+                           << " statements...";
 
             simplification_context ctx{ res };
 
-            auto all = when_all(fmap(
-                _statements, [&](auto && stmt) { return stmt->simplify({ ctx }).then([&](auto && simplified) { replace_uptr(stmt, simplified, ctx); }); }));
-            reaver::get(all);
+            {
+                phase_timer iteration_timer{ "iteration " + std::to_string(iteration) };
+
+                auto all = when_all(fmap(worklist, [&](auto index) {
+                    return _statements[index]->simplify({ ctx, {}, &dependencies }).then([&, index](auto && simplified) {
+                        // the replacement is recorded as made in the new statement, so that it's simplified again
+                        replace_uptr(_statements[index], simplified, recursive_context{ ctx, {}, &dependencies, simplified });
+                    });
+                }));
+                reaver::get(all);
+            }
+
+            std::unordered_map<const statement *, std::size_t> roots;
+            for (std::size_t i = 0; i < _statements.size(); ++i)
+            {
+                roots.emplace(_statements[i].get(), i);
+            }
 
-            cont = ctx.did_something_happen();
+            worklist = dependencies.take_affected(roots);
 
-            logger::dlog() << "Simplification run of module " << utf8(name()) << " finished.";
+            // the replacements are meant to be made through contexts that know the nodes they're made in; if one wasn't, its
+            // effects are unknown, and the whole module has to be simplified again, like it would be without the dependencies
+            if (ctx.did_something_untracked_happen() || (reruns == simplification_reruns::all && ctx.did_something_happen()))
+            {
+                worklist.resize(_statements.size());
+                std::iota(worklist.begin(), worklist.end(), 0);
+            }
 
-            std::stringstream ss;
-            print(ss, {});
-            logger::dlog() << ss.str();
-            logger::default_logger().sync();
+            logger::dlog() << "Simplification run of module " << utf8(name()) << " finished.";
         }
 
         logger::dlog() << "Simplification of module " << utf8(name()) << " finished.";
@@ -124,7 +155,7 @@ inline namespace _v1
         auto ctx = ir_generation_context{};
 
         codegen::ir::module mod;
-        mod.name = fmap(_parse.name.id_expression_value, [&](auto && ident) { return ident.value.string; });
+        mod.name = fmap(_parse.name.id_expression_value, [&](auto && ident) { return ident.value.string.str(); });
 
         mod.symbols = mbind(_scope->symbols_in_order(), [&](auto && symbol) {
             return mbind(symbol->codegen_ir(ctx), [&](auto && decl) {
@@ -77,7 +77,7 @@ inline namespace _v1
         }
     }
 
-    bool scope::init(const std::u32string & name, std::unique_ptr<symbol> symb)
+    bool scope::init(identifier_id name, std::unique_ptr<symbol> symb)
     {
         if (non_overridable().find(name) != non_overridable().end())
         {
@@ -106,7 +106,7 @@ inline namespace _v1
         return true;
     }
 
-    future<symbol *> scope::get_future(const std::u32string & name) const
+    future<symbol *> scope::get_future(identifier_id name) const
     {
         {
             _shlock lock{ _lock };
@@ -144,7 +144,7 @@ inline namespace _v1
         return _symbol_futures.emplace(name, std::move(pair.future)).first->second;
     }
 
-    future<symbol *> scope::resolve(const std::u32string & name) const
+    future<symbol *> scope::resolve(identifier_id name) const
     {
         {
             auto it = non_overridable().find(name);
@@ -200,7 +200,7 @@ inline namespace _v1
         return std::move(pair.future);
     }
 
-    const std::unordered_map<std::u32string, std::unique_ptr<symbol>> & non_overridable()
+    const std::unordered_map<identifier_id, std::unique_ptr<symbol>> & non_overridable()
     {
         static auto integer_type_expr = builtin_types().integer->get_expression();
         static auto boolean_type_expr = builtin_types().boolean->get_expression();
@@ -216,13 +216,7 @@ inline namespace _v1
                 auto int_var = static_cast<integer_constant *>(args[1]);
                 auto size = int_var->get_value().convert_to<std::size_t>();
 
-                auto & type = ctx.sized_integers[size];
-                if (!type)
-                {
-                    type = make_sized_integer_type(size);
-                }
-
-                expr->replace_with(make_expression_ref(type->get_expression()));
+                expr->replace_with(make_expression_ref(ctx.get_sized_integer_type(size)->get_expression()));
 
                 return make_ready_future();
             });
@@ -233,7 +227,7 @@ inline namespace _v1
         static auto sized_int_expr = std::unique_ptr<expression>{ reaver::get(make_function_expression(sized_int.get())) };
 
         static auto symbols = [&] {
-            std::unordered_map<std::u32string, std::unique_ptr<symbol>> symbols;
+            std::unordered_map<identifier_id, std::unique_ptr<symbol>> symbols;
 
             auto add_symbol = [&](auto name, auto && expr) { symbols.emplace(name, make_symbol(name, expr)); };
 
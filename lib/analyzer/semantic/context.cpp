@@ -24,3 +24,23 @@
 #include "vapor/analyzer/expressions/expression.h"
 #include "vapor/analyzer/statements/statement.h"
 #include "vapor/analyzer/symbol.h"
+#include "vapor/analyzer/types/sized_integer.h"
+
+namespace reaver::vapor::analyzer
+{
+inline namespace _v1
+{
+    type * analysis_context::get_sized_integer_type(std::size_t size)
+    {
+        std::lock_guard<std::mutex> lock{ _sized_integers_lock };
+
+        auto & type = _sized_integers[size];
+        if (!type)
+        {
+            type = make_sized_integer_type(size);
+        }
+
+        return type.get();
+    }
+}
+}
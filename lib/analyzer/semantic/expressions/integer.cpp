@@ -32,9 +32,10 @@ inline namespace _v1
     {
         if (auto sized_target = dynamic_cast<sized_integer *>(target))
         {
-            if (_value <= sized_target->max_value() && _value >= sized_target->min_value())
+            sized_integer_value value{ _value };
+            if (value <= sized_target->max_value() && value >= sized_target->min_value())
             {
-                return std::make_unique<sized_integer_constant>(sized_target, _value);
+                return std::make_unique<sized_integer_constant>(sized_target, std::move(value));
             }
         }
 
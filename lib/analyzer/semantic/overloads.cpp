@@ -133,7 +133,7 @@ inline namespace _v1
 
                 if (succeeded_before)
                 {
-                    logger::dlog() << overload->explain() << " not considered; mismatch in member assignment arguments; ." << utf8(arg->member_name())
+                    logger::dlog() << overload->explain() << " not considered; mismatch in member assignment arguments; ." << utf8(arg->member_name().string())
                                    << " did not match any members";
                     return false;
                 }
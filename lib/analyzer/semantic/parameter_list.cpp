@@ -38,10 +38,10 @@ inline namespace _v1
             assert(param_parse.type);
 
             auto param =
-                std::make_unique<parameter>(make_node(param_parse), param_parse.name.value.string, preanalyze_expression(param_parse.type.get(), lex_scope));
+                std::make_unique<parameter>(make_node(param_parse), param_parse.name.value.string.str(), preanalyze_expression(param_parse.type.get(), lex_scope));
 
-            auto symb = make_symbol(param_parse.name.value.string, param.get());
-            lex_scope->init(param_parse.name.value.string, std::move(symb));
+            auto symb = make_symbol(param_parse.name.value.id, param.get());
+            lex_scope->init(param_parse.name.value.id, std::move(symb));
 
             return param;
         });
@@ -60,6 +60,8 @@ inline namespace _v1
 
     void cached_results::save_call_result(call_frame frame, std::unique_ptr<expression> expr)
     {
+        std::unique_lock<std::shared_mutex> lock{ _lock };
+
         auto it = _cached_call_results.find(frame);
         if (it == _cached_call_results.end())
         {
@@ -73,6 +75,8 @@ inline namespace _v1
 
     std::unique_ptr<expression> cached_results::get_call_result(call_frame frame) const
     {
+        std::shared_lock<std::shared_mutex> lock{ _lock };
+
         auto it = _cached_call_results.find(frame);
         if (it != _cached_call_results.end())
         {
@@ -85,16 +89,6 @@ inline namespace _v1
 
     simplification_context::~simplification_context() = default;
 
-    void simplification_context::_handle_expressions(expression * ptr, future<expression *> & fut)
-    {
-        if (_statement_futures.find(ptr) != _statement_futures.end())
-        {
-            return;
-        }
-
-        _statement_futures.emplace(ptr, fut.then([](auto && expr) { return static_cast<statement *>(expr); }));
-    }
-
     void simplification_context::keep_alive(statement * ptr)
     {
         std::lock_guard<std::mutex> lock{ _keep_alive_lock };
@@ -0,0 +1,81 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include "vapor/analyzer/simplification/dependencies.h"
+
+#include <algorithm>
+
+namespace reaver::vapor::analyzer
+{
+inline namespace _v1
+{
+    void dependency_graph::add_use(const statement * used, const statement * user)
+    {
+        _users.update(used, [&](auto && users) { users.insert(user); });
+    }
+
+    void dependency_graph::mark_dirty(const statement * node)
+    {
+        std::lock_guard<std::mutex> lock{ _dirty_lock };
+        _dirty.insert(node);
+    }
+
+    std::vector<std::size_t> dependency_graph::take_affected(const std::unordered_map<const statement *, std::size_t> & roots)
+    {
+        std::vector<const statement *> worklist;
+        {
+            std::lock_guard<std::mutex> lock{ _dirty_lock };
+            worklist.assign(_dirty.begin(), _dirty.end());
+            _dirty.clear();
+        }
+
+        std::unordered_set<const statement *> visited{ worklist.begin(), worklist.end() };
+        std::vector<std::size_t> affected;
+
+        while (!worklist.empty())
+        {
+            auto node = worklist.back();
+            worklist.pop_back();
+
+            auto root = roots.find(node);
+            if (root != roots.end())
+            {
+                affected.push_back(root->second);
+            }
+
+            if (auto users = _users.find(node))
+            {
+                for (auto && user : *users)
+                {
+                    if (visited.insert(user).second)
+                    {
+                        worklist.push_back(user);
+                    }
+                }
+            }
+        }
+
+        std::sort(affected.begin(), affected.end());
+        return affected;
+    }
+}
+}
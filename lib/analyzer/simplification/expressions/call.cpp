@@ -67,7 +67,7 @@ inline namespace _v1
                 if (repl[i] && repl[i] != _args[i])
                 {
                     _args[i] = repl[i];
-                    ctx.proper.something_happened();
+                    ctx.something_happened();
                 }
             }
 
@@ -81,13 +81,13 @@ inline namespace _v1
         if (_replacement_expr)
         {
             return _replacement_expr->simplify_expr(ctx).then([&, ctx](auto && repl) -> expression * {
-                replace_uptr(_replacement_expr, repl, ctx.proper);
+                replace_uptr(_replacement_expr, repl, ctx);
                 return this;
             });
         }
 
         return when_all(fmap(_var_exprs, [&](auto && arg) { return arg->simplify_expr(ctx); })).then([&, ctx](auto && repl) {
-            replace_uptrs(_var_exprs, repl, ctx.proper);
+            replace_uptrs(_var_exprs, repl, ctx);
             return this->call_expression::_simplify_expr(ctx);
         });
     }
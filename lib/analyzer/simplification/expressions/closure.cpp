@@ -36,8 +36,8 @@ inline namespace _v1
 
     future<expression *> closure::_simplify_expr(recursive_context ctx)
     {
-        return _body->simplify(ctx).then([&](auto && simplified) -> expression * {
-            replace_uptr(_body, dynamic_cast<block *>(simplified), ctx.proper);
+        return _body->simplify(ctx).then([&, ctx](auto && simplified) -> expression * {
+            replace_uptr(_body, dynamic_cast<block *>(simplified), ctx);
             return this;
         });
     }
@@ -34,8 +34,8 @@ inline namespace _v1
 {
     future<expression *> expression_list::_simplify_expr(recursive_context ctx)
     {
-        return when_all(fmap(value, [&](auto && expr) { return expr->simplify_expr(ctx); })).then([&](auto && simplified) -> expression * {
-            replace_uptrs(value, simplified, ctx.proper);
+        return when_all(fmap(value, [&](auto && expr) { return expr->simplify_expr(ctx); })).then([&, ctx](auto && simplified) -> expression * {
+            replace_uptrs(value, simplified, ctx);
             assert(0);
             return this;
         });
@@ -86,11 +86,11 @@ inline namespace _v1
 
         return when_all(fmap(_arguments, [&, ctx](auto && expr) { return expr->simplify_expr(ctx); }))
             .then([&, ctx](auto && simplified) {
-                replace_uptrs(_arguments, simplified, ctx.proper);
+                replace_uptrs(_arguments, simplified, ctx);
                 return _base_expr->simplify_expr(ctx);
             })
             .then([&, ctx](auto && simplified) {
-                replace_uptr(_base_expr, simplified, ctx.proper);
+                replace_uptr(_base_expr, simplified, ctx);
 
                 if (!_modifier)
                 {
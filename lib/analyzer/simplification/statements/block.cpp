@@ -81,7 +81,7 @@ inline namespace _v1
         if (!_value_expr && _statements.size() == 1)
         {
             return _statements.front()->simplify(ctx).then([&, ctx](auto && simpl) {
-                replace_uptr(_statements.front(), simpl, ctx.proper);
+                replace_uptr(_statements.front(), simpl, ctx);
                 return _statements.front().release();
             });
         }
@@ -94,7 +94,7 @@ inline namespace _v1
                 }
 
                 return statement->simplify(ctx).then([&, ctx](auto && simplified) {
-                    replace_uptr(statement, simplified, ctx.proper);
+                    replace_uptr(statement, simplified, ctx);
                     return !statement->always_returns();
                 });
             });
@@ -108,7 +108,7 @@ inline namespace _v1
                 }
 
                 return expr->simplify_expr(ctx).then([&, ctx](auto && simplified) {
-                    replace_uptr(*_value_expr, simplified, ctx.proper);
+                    replace_uptr(*_value_expr, simplified, ctx);
                     return true;
                 });
             });
@@ -39,7 +39,7 @@ inline namespace _v1
         fmap(_init_expr, [&](auto && expr) {
             fut = expr->simplify_expr(ctx)
                       .then([&, ctx](auto && simplified) {
-                          replace_uptr(_init_expr.get(), simplified, ctx.proper);
+                          replace_uptr(_init_expr.get(), simplified, ctx);
                           return _declared_symbol->simplify(ctx);
                       })
                       .then([&]() -> statement * { return _init_expr->release(); });
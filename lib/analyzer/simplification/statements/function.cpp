@@ -35,8 +35,8 @@ inline namespace _v1
 {
     future<statement *> function_definition::_simplify(recursive_context ctx)
     {
-        return _body->simplify(ctx).then([&](auto && simplified) -> statement * {
-            replace_uptr(_body, dynamic_cast<block *>(simplified), ctx.proper);
+        return _body->simplify(ctx).then([&, ctx](auto && simplified) -> statement * {
+            replace_uptr(_body, dynamic_cast<block *>(simplified), ctx);
             return this;
         });
     }
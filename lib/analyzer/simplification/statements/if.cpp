@@ -43,14 +43,14 @@ inline namespace _v1
     future<statement *> if_statement::_simplify(recursive_context ctx)
     {
         auto future = _condition->simplify_expr(ctx)
-                          .then([&, ctx](auto && simplified) { replace_uptr(_condition, simplified, ctx.proper); })
+                          .then([&, ctx](auto && simplified) { replace_uptr(_condition, simplified, ctx); })
                           .then([&, ctx] { return _then_block->simplify(ctx); })
-                          .then([&, ctx](auto && simpl) { replace_uptr(_then_block, simpl, ctx.proper); });
+                          .then([&, ctx](auto && simpl) { replace_uptr(_then_block, simpl, ctx); });
 
         if (_else_block)
         {
             future = future.then([&, ctx] { return _else_block.get()->simplify(ctx); }).then([&, ctx](auto && simpl) {
-                replace_uptr(_else_block.get(), simpl, ctx.proper);
+                replace_uptr(_else_block.get(), simpl, ctx);
             });
         }
 
@@ -37,9 +37,11 @@ inline namespace _v1
 {
     std::unique_ptr<block> preanalyze_block(const parser::block & parse, scope * lex_scope, bool is_top_level)
     {
+        // this is where the bodies whose parsing has been deferred get parsed
+        auto & contents = parser::parsed(parse);
         auto scope = lex_scope->clone_local();
 
-        auto statements = fmap(parse.block_value, [&](auto && row) {
+        auto statements = fmap(contents.block_value, [&](auto && row) {
             return get<0>(fmap(row,
                 make_overload_set([&](const parser::block & block) -> std::unique_ptr<statement> { return preanalyze_block(block, scope.get(), false); },
                     [&](const parser::statement & statement) {
@@ -61,7 +63,7 @@ inline namespace _v1
             std::move(scope),
             lex_scope,
             std::move(statements),
-            fmap(parse.value_expression, [&](auto && val_expr) { return preanalyze_expression_list(val_expr, scope_ptr); }),
+            fmap(contents.value_expression, [&](auto && val_expr) { return preanalyze_expression_list(val_expr, scope_ptr); }),
             is_top_level);
     }
 
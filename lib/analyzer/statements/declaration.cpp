@@ -41,7 +41,7 @@ inline namespace _v1
         }
 
         auto ret = std::make_unique<declaration>(make_node(parse),
-            parse.identifier.value.string,
+            parse.identifier.value.string.str(),
             fmap(parse.rhs, [&](auto && expr) { return preanalyze_expression(expr, old_scope); }),
             fmap(parse.type_expression, [&](auto && expr) { return preanalyze_expression(expr, old_scope); }),
             new_scope,
@@ -45,7 +45,7 @@ inline namespace _v1
         function_scope->close();
 
         return std::make_unique<function_definition>(make_node(parse),
-            parse.signature.name.value.string,
+            parse.signature.name.value.string.str(),
             std::move(params),
             fmap(parse.signature.return_type, [&](auto && ret_type) { return preanalyze_expression(ret_type, function_scope.get()); }),
             preanalyze_block(*parse.body, function_scope.get(), true),
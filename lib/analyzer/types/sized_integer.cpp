@@ -91,7 +91,9 @@ inline namespace _v1
             BUILTIN_NAME, "<builtin sized_integer(" + std::to_string(_size) + ") " #NAME ">", eval, RESULT_TYPE);                                              \
     }
 
-    sized_integer::sized_integer(std::size_t size) : _size{ size }
+    sized_integer::sized_integer(std::size_t size)
+        : _size{ size }, _max_value{ boost::multiprecision::cpp_int{ (boost::multiprecision::cpp_int(1) << size) - 1 } },
+          _min_value{ boost::multiprecision::cpp_int{ -(boost::multiprecision::cpp_int(1) << size) } }
     {
         auto u32size = utf32(std::to_string(size));
 
@@ -101,9 +103,6 @@ inline namespace _v1
         ADD_OPERATION(equal_comparison, U"__builtin_sized_integer_" + u32size + U"_operator_equals", ==, builtin_types().boolean.get(), boolean, ());
         ADD_OPERATION(less_comparison, U"__builtin_sized_integer_" + u32size + U"_operator_less", <, builtin_types().boolean.get(), boolean, ());
         ADD_OPERATION(less_equal_comparison, U"__builtin_sized_" + u32size + U"_integer_operator_less_equal", <, builtin_types().boolean.get(), boolean, ());
-
-        _max_value = (boost::multiprecision::cpp_int(1) << _size) - 1;
-        _min_value = -_max_value - 1;
     }
 }
 }
@@ -0,0 +1,131 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <algorithm>
+#include <iterator>
+
+#include <reaver/exception.h>
+
+#include "vapor/lexer/detail/tokenizer.h"
+#include "vapor/lexer/incremental.h"
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    namespace
+    {
+        void check(const text_edit & edit, std::size_t length)
+        {
+            if (edit.begin > edit.end || edit.end > length)
+            {
+                throw exception(logger::error) << "invalid text edit: [" << edit.begin << ", " << edit.end << ") in a text of length " << length;
+            }
+        }
+    }
+
+    void apply_edit(std::u32string & text, const text_edit & edit)
+    {
+        check(edit, text.size());
+        text.replace(edit.begin, edit.end - edit.begin, edit.replacement);
+    }
+
+    token_change relex(std::vector<token> & tokens, const std::u32string & text, const text_edit & edit, file_id file)
+    {
+        // only the start of the edit is known to be in both texts
+        check({ edit.begin, edit.begin, {} }, text.size());
+
+        const std::uint32_t inserted_end = edit.begin + edit.replacement.size();
+        if (inserted_end > text.size())
+        {
+            throw exception(logger::error) << "the edited text is too short for the edit: " << text.size() << " code points, the edit ends at " << inserted_end;
+        }
+
+        const std::int64_t delta = static_cast<std::int64_t>(edit.replacement.size()) - (edit.end - edit.begin);
+
+        // a token is damaged when the edit touches any character the lexer has looked at while lexing it: its own characters,
+        // and up to two characters after it when it's matched as the longest of the operators starting with its characters
+        auto first = std::partition_point(tokens.begin(), tokens.end(), [&](const token & tok) { return tok.range.end().offset + 2 <= edit.begin; });
+        auto index = static_cast<std::size_t>(first - tokens.begin());
+
+        // right after an undamaged token, the lexer is in the same state in both texts
+        std::uint32_t restart = index ? tokens[index - 1].range.end().offset : 0;
+        _detail::_tokenizer<std::u32string::const_iterator> lexer{ text.begin() + restart, text.end(), file, restart };
+
+        std::vector<token> relexed;
+        auto old = first;
+        bool synchronized = false;
+
+        while (!synchronized && !lexer.done())
+        {
+            auto count = relexed.size();
+            lexer.lex(relexed, 1);
+
+            if (relexed.size() == count || relexed.back().range.start().offset < inserted_end)
+            {
+                continue;
+            }
+
+            // past the edit the texts are the same, so once a token starts where an old one did, so do all the following ones
+            std::int64_t old_start = relexed.back().range.start().offset - delta;
+            while (old != tokens.end() && old->range.start().offset < old_start)
+            {
+                ++old;
+            }
+
+            if (old != tokens.end() && old->range.start().offset == old_start)
+            {
+                relexed.pop_back();
+                synchronized = true;
+            }
+        }
+
+        if (!synchronized)
+        {
+            old = tokens.end();
+        }
+
+        token_change change{ index, static_cast<std::size_t>(old - first), relexed.size() };
+
+        auto shift = [&](const position & pos) { return position(static_cast<std::uint32_t>(pos.offset + delta), pos.file); };
+        for (auto it = old; it != tokens.end(); ++it)
+        {
+            it->range = range_type(shift(it->range.start()), shift(it->range.end()));
+        }
+
+        // most edits replace as many tokens as they remove, so avoid moving the whole tail of the stream if possible
+        auto common = std::min(change.removed, change.inserted);
+        first = std::move(relexed.begin(), relexed.begin() + common, first);
+
+        if (change.removed > common)
+        {
+            tokens.erase(first, old);
+        }
+        else
+        {
+            tokens.insert(first, std::make_move_iterator(relexed.begin() + common), std::make_move_iterator(relexed.end()));
+        }
+
+        return change;
+    }
+}
+}
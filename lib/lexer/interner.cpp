@@ -0,0 +1,116 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "vapor/lexer/interner.h"
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    namespace
+    {
+        // the strings are kept in segments that double in size, so that an ID can be turned into its string
+        // without taking the lock; a segment never moves, and its slots are only written before their IDs are handed out
+        constexpr std::size_t first_segment_bits = 10;
+        constexpr std::size_t first_segment_size = 1 << first_segment_bits;
+        constexpr std::size_t segment_count = 23;
+
+        // segment n holds the indices [first_segment_size * 2^n, first_segment_size * 2^(n + 1)), after offsetting
+        std::pair<std::size_t, std::size_t> slot(std::uint32_t id)
+        {
+            unsigned long long index = std::size_t{ id } - 1 + first_segment_size;
+            std::size_t segment = 63 - __builtin_clzll(index) - first_segment_bits;
+            return { segment, index - (first_segment_size << segment) };
+        }
+
+        struct interned_strings
+        {
+            std::shared_mutex lock;
+            std::array<std::atomic<std::u32string *>, segment_count> segments{};
+            std::uint32_t size = 0;
+            std::unordered_map<std::u32string_view, std::uint32_t> index;
+        };
+
+        interned_strings & strings()
+        {
+            static interned_strings table;
+            return table;
+        }
+    }
+
+    std::uint32_t _detail::_intern_id(std::u32string_view str)
+    {
+        auto & table = strings();
+
+        {
+            std::shared_lock<std::shared_mutex> lock{ table.lock };
+            auto it = table.index.find(str);
+            if (it != table.index.end())
+            {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock{ table.lock };
+
+        // need to repeat due to a logical race between the check before
+        // and re-locking the lock
+        auto it = table.index.find(str);
+        if (it != table.index.end())
+        {
+            return it->second;
+        }
+
+        // 0 is reserved for the empty string
+        auto id = ++table.size;
+        auto position = slot(id);
+
+        auto segment = table.segments[position.first].load(std::memory_order_relaxed);
+        if (!segment)
+        {
+            segment = new std::u32string[first_segment_size << position.first];
+            table.segments[position.first].store(segment, std::memory_order_release);
+        }
+
+        segment[position.second] = std::u32string{ str };
+        table.index.emplace(segment[position.second], id);
+        return id;
+    }
+
+    const std::u32string & _detail::_interned(std::uint32_t id)
+    {
+        auto position = slot(id);
+        return strings().segments[position.first].load(std::memory_order_acquire)[position.second];
+    }
+
+    std::u32string_view intern(std::u32string_view str)
+    {
+        return _detail::_interned(_detail::_intern_id(str));
+    }
+}
+}
@@ -116,6 +116,17 @@ inline namespace _v1
         return {};
     }();
 
+    const std::array<std::u32string, +token_type::count> token_spellings = [] {
+        std::array<std::u32string, +token_type::count> spellings;
+
+        for (std::size_t i = 0; i < spellings.size(); ++i)
+        {
+            spellings[i] = utf32(token_types[i]);
+        }
+
+        return spellings;
+    }();
+
     const std::unordered_map<std::u32string, token_type> keywords = {
         { U"true", token_type::boolean },
         { U"false", token_type::boolean },
@@ -171,7 +182,7 @@ inline namespace _v1
         { '>', { { '>', token_type::right_shift }, { '=', token_type::greater_equal } } },
         { '=', { { '>', token_type::block_value }, { '=', token_type::equals } } },
         { '&', { { '&', token_type::logical_and }, { '=', token_type::bitwise_and_assignment } } },
-        { '|', { { '|', token_type::logical_or }, { '=', token_type::bitwise_and_assignment } } },
+        { '|', { { '|', token_type::logical_or }, { '=', token_type::bitwise_or_assignment } } },
         { '!', { { '=', token_type::not_equals } } },
         { '~', { { '=', token_type::bitwise_not_assignment } } },
         { '+', { { '=', token_type::plus_assignment } } },
@@ -179,8 +190,6 @@ inline namespace _v1
         { '*', { { '=', token_type::star_assignment } } },
         { '/', { { '=', token_type::slash_assignment } } },
         { '%', { { '=', token_type::modulo_assignment } } },
-        { '&', { { '=', token_type::bitwise_and_assignment } } },
-        { '|', { { '=', token_type::bitwise_or_assignment } } },
         { '^', { { '=', token_type::bitwise_xor_assignment } } }
     };
 
@@ -0,0 +1,247 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <atomic>
+#include <cassert>
+#include <initializer_list>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "vapor/lexer/detail/scan_kernels.h"
+#include "vapor/lexer/scan.h"
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    namespace scan
+    {
+        namespace
+        {
+            const char32_t * _scalar_skip_utf32(char_class cls, const char32_t * begin, const char32_t * end)
+            {
+                return _scalar_skip(cls, begin, end);
+            }
+
+            const char * _scalar_skip_utf8(char_class cls, const char * begin, const char * end)
+            {
+                return _scalar_skip(cls, begin, end);
+            }
+
+            const char32_t * _scalar_find_utf32(char32_t c, const char32_t * begin, const char32_t * end)
+            {
+                return _scalar_find(c, begin, end);
+            }
+
+            const char * _scalar_find_utf8(char c, const char * begin, const char * end)
+            {
+                return _scalar_find(c, begin, end);
+            }
+
+            constexpr _implementation _scalar_implementation = { &_scalar_skip_utf32, &_scalar_skip_utf8, &_scalar_find_utf32, &_scalar_find_utf8, &_scalar_count_code_points };
+
+#if defined(__SSE2__)
+            template<typename Char>
+            struct _sse2_ops
+            {
+                using char_type = Char;
+                using vec = __m128i;
+                static constexpr std::size_t width = 16 / sizeof(Char);
+
+                static vec load(const Char * ptr)
+                {
+                    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+                }
+
+                static vec splat(Char c)
+                {
+                    if constexpr (sizeof(Char) == 1)
+                    {
+                        return _mm_set1_epi8(c);
+                    }
+                    else
+                    {
+                        return _mm_set1_epi32(c);
+                    }
+                }
+
+                static vec equal(vec lhs, vec rhs)
+                {
+                    if constexpr (sizeof(Char) == 1)
+                    {
+                        return _mm_cmpeq_epi8(lhs, rhs);
+                    }
+                    else
+                    {
+                        return _mm_cmpeq_epi32(lhs, rhs);
+                    }
+                }
+
+                static vec greater(vec lhs, vec rhs)
+                {
+                    if constexpr (sizeof(Char) == 1)
+                    {
+                        return _mm_cmpgt_epi8(lhs, rhs);
+                    }
+                    else
+                    {
+                        return _mm_cmpgt_epi32(lhs, rhs);
+                    }
+                }
+
+                static vec bit_and(vec lhs, vec rhs)
+                {
+                    return _mm_and_si128(lhs, rhs);
+                }
+
+                static vec bit_or(vec lhs, vec rhs)
+                {
+                    return _mm_or_si128(lhs, rhs);
+                }
+
+                // one bit per lane
+                static std::uint32_t mask(vec v)
+                {
+                    if constexpr (sizeof(Char) == 1)
+                    {
+                        return _mm_movemask_epi8(v);
+                    }
+                    else
+                    {
+                        return _mm_movemask_ps(_mm_castsi128_ps(v));
+                    }
+                }
+            };
+
+            constexpr _implementation _sse2_implementation = _make_implementation<_sse2_ops<char32_t>, _sse2_ops<char>>();
+#endif
+
+            const _implementation * _implementation_for(isa set)
+            {
+                switch (set)
+                {
+                    case isa::scalar:
+                        return &_scalar_implementation;
+
+                    case isa::sse2:
+#if defined(__SSE2__)
+                        return &_sse2_implementation;
+#else
+                        return nullptr;
+#endif
+
+                    case isa::avx2:
+#if defined(__x86_64__) || defined(__i386__)
+                        if (!__builtin_cpu_supports("avx2"))
+                        {
+                            return nullptr;
+                        }
+                        return _avx2_implementation();
+#else
+                        return nullptr;
+#endif
+                }
+
+                return nullptr;
+            }
+
+            isa _best_supported()
+            {
+                for (auto set : { isa::avx2, isa::sse2 })
+                {
+                    if (_implementation_for(set))
+                    {
+                        return set;
+                    }
+                }
+
+                return isa::scalar;
+            }
+
+            struct _selection
+            {
+                _selection() : set{ _best_supported() }, implementation{ _implementation_for(set.load()) }
+                {
+                }
+
+                std::atomic<isa> set;
+                std::atomic<const _implementation *> implementation;
+            };
+
+            _selection & _selected()
+            {
+                static _selection selection;
+                return selection;
+            }
+
+            const _implementation & _current()
+            {
+                return *_selected().implementation.load(std::memory_order_relaxed);
+            }
+        }
+
+        const char32_t * skip(char_class cls, const char32_t * begin, const char32_t * end)
+        {
+            return _current().skip_utf32(cls, begin, end);
+        }
+
+        const char * skip(char_class cls, const char * begin, const char * end)
+        {
+            return _current().skip_utf8(cls, begin, end);
+        }
+
+        const char32_t * find(char32_t c, const char32_t * begin, const char32_t * end)
+        {
+            return _current().find_utf32(c, begin, end);
+        }
+
+        const char * find(char c, const char * begin, const char * end)
+        {
+            return _current().find_utf8(c, begin, end);
+        }
+
+        std::size_t count_code_points(const char * begin, const char * end)
+        {
+            return _current().count_code_points(begin, end);
+        }
+
+        bool supported(isa set)
+        {
+            return _implementation_for(set) != nullptr;
+        }
+
+        isa selected()
+        {
+            return _selected().set.load();
+        }
+
+        void select(isa set)
+        {
+            assert(supported(set));
+            _selected().implementation = _implementation_for(set);
+            _selected().set = set;
+        }
+    }
+}
+}
@@ -0,0 +1,128 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+// this file is built with -mavx2 (see the Makefile); nothing in it may be called
+// before checking that the CPU supports AVX2
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "vapor/lexer/detail/scan_kernels.h"
+
+namespace reaver::vapor::lexer
+{
+inline namespace _v1
+{
+    namespace scan
+    {
+#if defined(__AVX2__)
+        namespace
+        {
+            template<typename Char>
+            struct _avx2_ops
+            {
+                using char_type = Char;
+                using vec = __m256i;
+                static constexpr std::size_t width = 32 / sizeof(Char);
+
+                static vec load(const Char * ptr)
+                {
+                    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+                }
+
+                static vec splat(Char c)
+                {
+                    if constexpr (sizeof(Char) == 1)
+                    {
+                        return _mm256_set1_epi8(c);
+                    }
+                    else
+                    {
+                        return _mm256_set1_epi32(c);
+                    }
+                }
+
+                static vec equal(vec lhs, vec rhs)
+                {
+                    if constexpr (sizeof(Char) == 1)
+                    {
+                        return _mm256_cmpeq_epi8(lhs, rhs);
+                    }
+                    else
+                    {
+                        return _mm256_cmpeq_epi32(lhs, rhs);
+                    }
+                }
+
+                static vec greater(vec lhs, vec rhs)
+                {
+                    if constexpr (sizeof(Char) == 1)
+                    {
+                        return _mm256_cmpgt_epi8(lhs, rhs);
+                    }
+                    else
+                    {
+                        return _mm256_cmpgt_epi32(lhs, rhs);
+                    }
+                }
+
+                static vec bit_and(vec lhs, vec rhs)
+                {
+                    return _mm256_and_si256(lhs, rhs);
+                }
+
+                static vec bit_or(vec lhs, vec rhs)
+                {
+                    return _mm256_or_si256(lhs, rhs);
+                }
+
+                // one bit per lane
+                static std::uint32_t mask(vec v)
+                {
+                    if constexpr (sizeof(Char) == 1)
+                    {
+                        return _mm256_movemask_epi8(v);
+                    }
+                    else
+                    {
+                        return _mm256_movemask_ps(_mm256_castsi256_ps(v));
+                    }
+                }
+            };
+
+            constexpr _implementation _avx2 = _make_implementation<_avx2_ops<char32_t>, _avx2_ops<char>>();
+        }
+
+        const _implementation * _avx2_implementation()
+        {
+            return &_avx2;
+        }
+#else
+        const _implementation * _avx2_implementation()
+        {
+            return nullptr;
+        }
+#endif
+    }
+}
+}
@@ -0,0 +1,96 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <reaver/exception.h>
+
+#include "vapor/mapped_file.h"
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    mapped_file::mapped_file(const std::string & path)
+    {
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+        {
+            throw exception(logger::fatal) << "failed to open " << path << ": " << std::strerror(errno);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) == -1)
+        {
+            auto error = errno;
+            ::close(fd);
+            throw exception(logger::fatal) << "failed to stat " << path << ": " << std::strerror(error);
+        }
+
+        _size = info.st_size;
+
+        // mmap refuses empty mappings; an empty file is just an empty view
+        if (_size != 0)
+        {
+            auto address = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED)
+            {
+                auto error = errno;
+                ::close(fd);
+                throw exception(logger::fatal) << "failed to map " << path << ": " << std::strerror(error);
+            }
+
+            // the lexer reads the file front to back
+            ::madvise(address, _size, MADV_SEQUENTIAL);
+            _data = static_cast<const char *>(address);
+        }
+
+        ::close(fd);
+    }
+
+    mapped_file::~mapped_file()
+    {
+        if (_data)
+        {
+            ::munmap(const_cast<char *>(_data), _size);
+        }
+    }
+
+    mapped_file::mapped_file(mapped_file && other) noexcept : _data{ std::exchange(other._data, nullptr) }, _size{ std::exchange(other._size, 0) }
+    {
+    }
+
+    mapped_file & mapped_file::operator=(mapped_file && other) noexcept
+    {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        return *this;
+    }
+}
+}
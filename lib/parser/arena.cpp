@@ -0,0 +1,134 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <algorithm>
+#include <new>
+
+#include "vapor/parser/arena.h"
+
+namespace reaver::vapor::parser
+{
+inline namespace _v1
+{
+    namespace
+    {
+        thread_local arena * current_arena = nullptr;
+
+        // precedes every node; the owner is null for nodes allocated from the heap
+        struct alignas(arena::alignment) node_header
+        {
+            arena * owner;
+            std::size_t size;
+        };
+
+        constexpr std::size_t max_block_size = 1024 * 1024;
+    }
+
+    void * arena::allocate(std::size_t size)
+    {
+        size = (size + alignment - 1) & ~(alignment - 1);
+
+        if (size <= max_recycled_size && _free[size / alignment])
+        {
+            auto ret = _free[size / alignment];
+            _free[size / alignment] = ret->next;
+            return ret;
+        }
+
+        if (static_cast<std::size_t>(_end - _current) < size)
+        {
+            // oversized requests get a block of their own, so that they don't waste the rest of the current one
+            if (size > _next_block_size / 2)
+            {
+                auto & block = _blocks.emplace_back(new char[size]);
+                _allocated += size;
+                return block.get();
+            }
+
+            auto & block = _blocks.emplace_back(new char[_next_block_size]);
+            _current = block.get();
+            _end = _current + _next_block_size;
+            _next_block_size = std::min(_next_block_size * 2, max_block_size);
+        }
+
+        auto ret = _current;
+        _current += size;
+        _allocated += size;
+        return ret;
+    }
+
+    void arena::deallocate(void * ptr, std::size_t size) noexcept
+    {
+        size = (size + alignment - 1) & ~(alignment - 1);
+
+        if (size <= max_recycled_size)
+        {
+            _free[size / alignment] = new (ptr) _free_block{ _free[size / alignment] };
+        }
+    }
+
+    arena_scope::arena_scope(arena * a) : _previous{ current_arena }
+    {
+        current_arena = a;
+    }
+
+    arena_scope::~arena_scope()
+    {
+        current_arena = _previous;
+    }
+
+    void * allocate_node(std::size_t size)
+    {
+        auto owner = current_arena;
+        size += sizeof(node_header);
+
+        // large blocks are storage of long vectors, which get reallocated as they grow; there's few of them, and leaving
+        // the old buffers in the arena would only waste memory
+        if (size > arena::max_recycled_size)
+        {
+            owner = nullptr;
+        }
+
+        auto header = static_cast<node_header *>(owner ? owner->allocate(size) : ::operator new(size));
+        header->owner = owner;
+        header->size = size;
+        return header + 1;
+    }
+
+    void deallocate_node(void * ptr) noexcept
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        auto header = static_cast<node_header *>(ptr) - 1;
+        if (header->owner)
+        {
+            header->owner->deallocate(header, header->size);
+            return;
+        }
+
+        ::operator delete(header);
+    }
+}
+}
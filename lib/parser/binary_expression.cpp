@@ -32,113 +32,193 @@ inline namespace _v1
         return lhs.range == rhs.range && lhs.op == rhs.op && lhs.lhs == rhs.lhs && lhs.rhs == rhs.rhs;
     }
 
-    const std::vector<reaver::vapor::lexer::_v1::token_type> & binary_operators()
+    namespace
     {
-        static std::vector<lexer::token_type> binary_ops = { lexer::token_type::plus,
-            lexer::token_type::minus,
-            lexer::token_type::star,
-            lexer::token_type::slash,
-            lexer::token_type::modulo,
-            lexer::token_type::bitwise_and,
-            lexer::token_type::bitwise_or,
-            lexer::token_type::bitwise_xor,
-            lexer::token_type::logical_and,
-            lexer::token_type::logical_or,
-            lexer::token_type::left_shift,
-            lexer::token_type::right_shift,
-
-            lexer::token_type::assign,
-            lexer::token_type::plus_assignment,
-            lexer::token_type::minus_assignment,
-            lexer::token_type::star_assignment,
-            lexer::token_type::slash_assignment,
-            lexer::token_type::modulo_assignment,
-            lexer::token_type::bitwise_and_assignment,
-            lexer::token_type::bitwise_or_assignment,
-            lexer::token_type::bitwise_xor_assignment,
-            lexer::token_type::logical_and_assignment,
-            lexer::token_type::logical_or_assignment,
-            lexer::token_type::left_shift_assignment,
-            lexer::token_type::right_shift_assignment,
-
-            lexer::token_type::equals,
-            lexer::token_type::not_equals,
-            lexer::token_type::less,
-            lexer::token_type::less_equal,
-            lexer::token_type::greater,
-            lexer::token_type::greater_equal,
-
-            lexer::token_type::indirection,
-            lexer::token_type::map,
-            lexer::token_type::bind };
-
-        return binary_ops;
-    }
+        // the chain is parsed into flat arrays first, and only then built into a tree, top to bottom; this way every
+        // operand is moved into its place once, instead of the whole left subtree being moved into every new node
+        // the buffers are shared by all the chains parsed on a thread, with the chains nested in operands stacked on top
+        struct chain_buffers
+        {
+            std::vector<expression> operands;
+            std::vector<lexer::token> operators;
+
+            // the chain in postfix order; operands are stored as their index, operators as the bitwise negation of it
+            std::vector<std::ptrdiff_t> postfix;
+            // indices of the operators whose right operand is still being parsed
+            std::vector<std::size_t> open;
+            // first and last operand of every subtree completed so far, and then of every operator
+            std::vector<std::pair<std::size_t, std::size_t>> subtrees;
+            std::vector<std::pair<std::size_t, std::size_t>> spans;
+
+            std::vector<expression *> slots;
+        };
+
+        thread_local chain_buffers buffers;
+
+        class chain_scope
+        {
+        public:
+            chain_scope(context & ctx)
+                : _ctx{ ctx },
+                  _enclosing{ ctx.enclosing_precedence },
+                  _operands{ buffers.operands.size() },
+                  _operators{ buffers.operators.size() },
+                  _postfix{ buffers.postfix.size() },
+                  _open{ buffers.open.size() },
+                  _subtrees{ buffers.subtrees.size() },
+                  _slots{ buffers.slots.size() }
+            {
+            }
 
-    const std::unordered_map<reaver::vapor::lexer::_v1::token_type, std::size_t> & binary_operator_precedences()
-    {
-        static std::unordered_map<lexer::token_type, std::size_t> precedences = []() {
-            std::unordered_map<lexer::token_type, std::size_t> precedences;
-
-            precedences[lexer::token_type::indirection] = 0;
-
-            precedences[lexer::token_type::star] = 10;
-            precedences[lexer::token_type::slash] = 10;
-            precedences[lexer::token_type::modulo] = 10;
-
-            precedences[lexer::token_type::plus] = 15;
-            precedences[lexer::token_type::minus] = 15;
-
-            precedences[lexer::token_type::left_shift] = 20;
-            precedences[lexer::token_type::right_shift] = 20;
-
-            precedences[lexer::token_type::less] = 25;
-            precedences[lexer::token_type::less_equal] = 25;
-            precedences[lexer::token_type::greater] = 25;
-            precedences[lexer::token_type::greater_equal] = 25;
-
-            precedences[lexer::token_type::equals] = 30;
-            precedences[lexer::token_type::not_equals] = 30;
-
-            precedences[lexer::token_type::bitwise_and] = 35;
-            precedences[lexer::token_type::bitwise_xor] = 40;
-            precedences[lexer::token_type::bitwise_or] = 45;
-            precedences[lexer::token_type::logical_and] = 50;
-            precedences[lexer::token_type::logical_or] = 55;
-
-            for (auto t : { lexer::token_type::assign,
-                     lexer::token_type::plus_assignment,
-                     lexer::token_type::minus_assignment,
-                     lexer::token_type::star_assignment,
-                     lexer::token_type::slash_assignment,
-                     lexer::token_type::left_shift_assignment,
-                     lexer::token_type::right_shift_assignment,
-                     lexer::token_type::bitwise_and_assignment,
-                     lexer::token_type::bitwise_not_assignment,
-                     lexer::token_type::bitwise_or_assignment,
-                     lexer::token_type::bitwise_xor_assignment,
-                     lexer::token_type::logical_and_assignment,
-                     lexer::token_type::logical_or_assignment })
+            ~chain_scope()
+            {
+                _ctx.enclosing_precedence = _enclosing;
+
+                buffers.operands.erase(buffers.operands.begin() + _operands, buffers.operands.end());
+                buffers.operators.erase(buffers.operators.begin() + _operators, buffers.operators.end());
+                buffers.spans.erase(buffers.spans.begin() + _operators, buffers.spans.end());
+                buffers.postfix.erase(buffers.postfix.begin() + _postfix, buffers.postfix.end());
+                buffers.open.erase(buffers.open.begin() + _open, buffers.open.end());
+                buffers.subtrees.erase(buffers.subtrees.begin() + _subtrees, buffers.subtrees.end());
+                buffers.slots.erase(buffers.slots.begin() + _slots, buffers.slots.end());
+            }
+
+            const optional<std::size_t> & enclosing() const
+            {
+                return _enclosing;
+            }
+
+            std::size_t operands() const
             {
-                precedences[t] = 60;
+                return _operands;
             }
 
-            return precedences;
-        }();
+            std::size_t operators() const
+            {
+                return _operators;
+            }
+
+            std::size_t postfix() const
+            {
+                return _postfix;
+            }
+
+            std::size_t open() const
+            {
+                return _open;
+            }
 
-        return precedences;
+        private:
+            context & _ctx;
+            optional<std::size_t> _enclosing;
+            std::size_t _operands;
+            std::size_t _operators;
+            std::size_t _postfix;
+            std::size_t _open;
+            std::size_t _subtrees;
+            std::size_t _slots;
+        };
+
+        void push_operand(expression operand)
+        {
+            auto index = buffers.operands.size();
+            buffers.operands.push_back(std::move(operand));
+            buffers.postfix.push_back(index);
+            buffers.subtrees.push_back({ index, index });
+        }
+
+        void close_operator()
+        {
+            auto index = buffers.open.back();
+            buffers.open.pop_back();
+            buffers.postfix.push_back(~static_cast<std::ptrdiff_t>(index));
+
+            auto rhs = buffers.subtrees.back();
+            buffers.subtrees.pop_back();
+            auto & lhs = buffers.subtrees.back();
+            lhs.second = rhs.second;
+            buffers.spans[index] = lhs;
+        }
+
+        binary_expression & emplace_binary_expression(expression & slot, range_type range, lexer::token op)
+        {
+            slot.range = range;
+            slot.expression_value = binary_expression{ range, std::move(op) };
+
+            binary_expression * ret = nullptr;
+            fmap(slot.expression_value,
+                make_overload_set(
+                    [&](binary_expression & expr) {
+                        ret = &expr;
+                        return unit{};
+                    },
+                    [](auto &&) { return unit{}; }));
+
+            return *ret;
+        }
     }
 
-    binary_expression parse_binary_expression(context & ctx, expression lhs)
+    expression parse_binary_expression(context & ctx, expression lhs)
     {
-        binary_expression ret;
-
-        ret.lhs = std::move(lhs);
-        ret.op = expect(ctx, peek(ctx)->type);
-        ctx.operator_stack.push_back({ ret.op.type, operator_type::binary });
-        ret.rhs = parse_expression(ctx);
-        ctx.operator_stack.pop_back();
-        ret.range = { ret.lhs.range.start(), ret.rhs.range.end() };
+        chain_scope scope{ ctx };
+
+        push_operand(std::move(lhs));
+
+        // this mirrors the recursive formulation, in which the right operand of every operator is a nested expression
+        // that takes in the following operators for as long as they bind tighter than that operator; the open
+        // operators are the stack of those nested expressions
+        while (peek(ctx) && is_binary_operator(peek(ctx)->type))
+        {
+            auto type = peek(ctx)->type;
+
+            while (buffers.open.size() > scope.open() && !binds_tighter(type, precedence(buffers.operators[buffers.open.back()].type)))
+            {
+                close_operator();
+            }
+
+            if (buffers.open.size() == scope.open() && !binds_tighter(type, scope.enclosing()))
+            {
+                break;
+            }
+
+            buffers.open.push_back(buffers.operators.size());
+            buffers.operators.push_back(expect(ctx, type));
+            buffers.spans.emplace_back();
+
+            ctx.enclosing_precedence = precedence(type);
+            push_operand(parse_operand(ctx));
+        }
+
+        while (buffers.open.size() > scope.open())
+        {
+            close_operator();
+        }
+
+        expression ret;
+
+        buffers.slots.push_back(&ret);
+        for (auto i = buffers.postfix.size(); i-- > scope.postfix();)
+        {
+            auto & slot = *buffers.slots.back();
+            buffers.slots.pop_back();
+
+            auto item = buffers.postfix[i];
+            if (item >= 0)
+            {
+                slot = std::move(buffers.operands[item]);
+                continue;
+            }
+
+            auto index = static_cast<std::size_t>(~item);
+            auto span = buffers.spans[index];
+            auto & expr = emplace_binary_expression(slot,
+                { buffers.operands[span.first].range.start(), buffers.operands[span.second].range.end() },
+                std::move(buffers.operators[index]));
+
+            // the postfix order is walked backwards, so the right operand comes first
+            buffers.slots.push_back(&expr.lhs);
+            buffers.slots.push_back(&expr.rhs);
+        }
 
         return ret;
     }
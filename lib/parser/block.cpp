@@ -20,6 +20,9 @@
  *
  **/
 
+#include <mutex>
+#include <vector>
+
 #include "vapor/parser/block.h"
 #include "vapor/parser/expr.h"
 
@@ -27,9 +30,49 @@ namespace reaver::vapor::parser
 {
 inline namespace _v1
 {
+    // the tokens of a deferred body, from its opening bracket to its closing one, copied out of the token stream, so that
+    // a deferred body doesn't keep the rest of the stream and the lexer alive; together with the options of the context
+    // it was found in
+    class deferred_body
+    {
+    public:
+        deferred_body(std::vector<lexer::token> tokens, const context & ctx) : _tokens{ std::move(tokens) }, _parsing{ ctx.parsing }, _bodies{ ctx.bodies }
+        {
+        }
+
+        const block & get() const
+        {
+            std::call_once(_once, [&] {
+                // the arena of the module is not meant to be used from other threads, and this may happen long
+                // after the module has been parsed
+                arena_scope scope{ nullptr };
+
+                // the tokens are not needed after this
+                context ctx;
+                ctx.begin = lexer::iterator{ std::move(_tokens) };
+                ctx.allocation = node_allocation::heap;
+                ctx.parsing = _parsing;
+                ctx.bodies = _bodies;
+                _block = std::make_unique<block>(parse_block(ctx));
+            });
+
+            return *_block;
+        }
+
+    private:
+        mutable std::vector<lexer::token> _tokens;
+        module_parsing _parsing;
+        body_parsing _bodies;
+        mutable std::once_flag _once;
+        mutable std::unique_ptr<block> _block;
+    };
+
     bool operator==(const block & lhs, const block & rhs)
     {
-        return lhs.range == rhs.range && lhs.block_value == rhs.block_value && lhs.value_expression == rhs.value_expression;
+        auto & lhs_contents = parsed(lhs);
+        auto & rhs_contents = parsed(rhs);
+        return lhs.range == rhs.range && lhs_contents.block_value == rhs_contents.block_value
+            && lhs_contents.value_expression == rhs_contents.value_expression;
     }
 
     block parse_block(context & ctx)
@@ -77,30 +120,89 @@ inline namespace _v1
         return ret;
     }
 
+    block parse_function_body(context & ctx)
+    {
+        if (peek(ctx, lexer::token_type::block_value))
+        {
+            return parse_single_statement_block(ctx);
+        }
+
+        // finding the end of the body walks the lexer iterator, which only points at the current token with nothing read ahead
+        if (ctx.bodies == body_parsing::eager || ctx.lookahead.ahead())
+        {
+            return parse_block(ctx);
+        }
+
+        block ret;
+
+        auto open = expect(ctx, lexer::token_type::curly_bracket_open);
+        auto start = open.range.start();
+        auto end = start;
+
+        std::vector<lexer::token> tokens;
+        tokens.push_back(std::move(open));
+
+        for (std::size_t depth = 1; depth != 0;)
+        {
+            if (ctx.begin == ctx.end)
+            {
+                throw expectation_failure{ lexer::token_type::curly_bracket_close };
+            }
+
+            auto & tok = *ctx.begin;
+            if (tok.type == lexer::token_type::curly_bracket_open)
+            {
+                ++depth;
+            }
+
+            else if (tok.type == lexer::token_type::curly_bracket_close)
+            {
+                --depth;
+            }
+
+            end = tok.range.end();
+            tokens.push_back(tok);
+            ++ctx.begin;
+        }
+
+        ret.range = { start, end };
+        ret.deferred = std::make_shared<const deferred_body>(std::move(tokens), ctx);
+
+        return ret;
+    }
+
+    const block & parsed(const block & bl)
+    {
+        return bl.deferred ? bl.deferred->get() : bl;
+    }
+
     void print(const block & bl, std::ostream & os, print_context ctx)
     {
+        // deferred bodies print the same as if they weren't deferred
+        auto & contents = parsed(bl);
+
         os << styles::def << ctx << styles::rule_name << "block";
         print_address_range(os, bl);
         os << '\n';
 
-        auto statements_ctx = ctx.make_branch(!bl.value_expression);
+        auto statements_ctx = ctx.make_branch(!contents.value_expression);
         os << statements_ctx << styles::subrule_name << "statements:\n";
 
         std::size_t idx = 0;
-        for (auto && element : bl.block_value)
+        for (auto && element : contents.block_value)
         {
             fmap(element, [&](const auto & value) -> unit {
-                print(value, os, statements_ctx.make_branch(++idx == bl.block_value.size()));
+                print(value, os, statements_ctx.make_branch(++idx == contents.block_value.size()));
                 return {};
             });
         }
 
-        if (bl.value_expression)
+        if (contents.value_expression)
         {
             auto value_ctx = ctx.make_branch(true);
             os << styles::def << value_ctx << styles::subrule_name << "value-expression:\n";
 
-            print(*bl.value_expression, os, value_ctx.make_branch(true));
+            print(*contents.value_expression, os, value_ctx.make_branch(true));
         }
     }
 }
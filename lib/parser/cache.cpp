@@ -0,0 +1,166 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2016-2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vapor/mapped_file.h"
+#include "vapor/parser/cache.h"
+#include "vapor/parser/serialization.h"
+
+namespace reaver::vapor::parser
+{
+inline namespace _v1
+{
+    namespace
+    {
+        std::uint64_t fnv1a(const void * data, std::size_t size, std::uint64_t hash = 14695981039346656037ull)
+        {
+            auto bytes = static_cast<const unsigned char *>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+        // the contents of the file, in the encoding it is kept in, as bytes
+        std::string_view raw_contents(const source_file & file)
+        {
+            if (file.is_utf8())
+            {
+                return file.utf8_contents();
+            }
+
+            auto & contents = file.contents();
+            return { reinterpret_cast<const char *>(contents.data()), contents.size() * sizeof(char32_t) };
+        }
+
+        // every entry starts with this, followed by the contents of the file it was parsed from, so that two files with the
+        // same hash can never load each other's trees: an encoding byte, and the size of the contents as 8 little endian bytes
+        std::string entry_header(const source_file & file)
+        {
+            auto size = static_cast<std::uint64_t>(raw_contents(file).size());
+
+            std::string header(1, file.is_utf8() ? '8' : '4');
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                header.push_back(static_cast<char>(size >> (i * 8)));
+            }
+
+            return header;
+        }
+    }
+
+    std::uint64_t content_hash(const source_file & file)
+    {
+        auto contents = raw_contents(file);
+
+        // UTF-32 contents hash differently from the same text in UTF-8; both still always map to the same entry
+        return file.is_utf8() ? fnv1a(contents.data(), contents.size()) : fnv1a(contents.data(), contents.size(), fnv1a("utf32", 5));
+    }
+
+    ast_cache::ast_cache(std::string directory) : _directory{ std::move(directory) }
+    {
+        if (::mkdir(_directory.c_str(), 0755) == -1 && errno != EEXIST)
+        {
+            throw exception(logger::fatal) << "failed to create the AST cache directory " << _directory << ": " << std::strerror(errno);
+        }
+    }
+
+    std::string ast_cache::path(const source_file & file) const
+    {
+        std::ostringstream os;
+        os << _directory << '/' << std::hex << content_hash(file) << ".vast";
+        return os.str();
+    }
+
+    optional<ast> ast_cache::load(const source_file & file) const
+    {
+        auto entry = path(file);
+        if (::access(entry.c_str(), R_OK) == -1)
+        {
+            return none;
+        }
+
+        try
+        {
+            // the whole entry is mapped, and read front to back once
+            mapped_file mapping{ entry };
+            auto data = mapping.view();
+
+            auto header = entry_header(file);
+            auto contents = raw_contents(file);
+            if (data.size() < header.size() + contents.size() || data.substr(0, header.size()) != header
+                || data.substr(header.size(), contents.size()) != contents)
+            {
+                return none;
+            }
+
+            return deserialize(data.substr(header.size() + contents.size()), file.id());
+        }
+
+        catch (exception &)
+        {
+            return none;
+        }
+    }
+
+    void ast_cache::store(const source_file & file, const ast & tree) const
+    {
+        auto entry = path(file);
+
+        std::ostringstream temporary;
+        temporary << entry << ".tmp." << ::getpid() << '.' << std::this_thread::get_id();
+
+        {
+            std::ofstream out{ temporary.str(), std::ios::binary | std::ios::trunc };
+            auto header = entry_header(file);
+            auto contents = raw_contents(file);
+            auto data = serialize(tree);
+            out.write(header.data(), header.size());
+            out.write(contents.data(), contents.size());
+            out.write(data.data(), data.size());
+
+            if (!out)
+            {
+                std::remove(temporary.str().c_str());
+                throw exception(logger::error) << "failed to write the AST cache entry " << entry;
+            }
+        }
+
+        if (std::rename(temporary.str().c_str(), entry.c_str()) != 0)
+        {
+            auto error = errno;
+            std::remove(temporary.str().c_str());
+            throw exception(logger::error) << "failed to write the AST cache entry " << entry << ": " << std::strerror(error);
+        }
+    }
+}
+}
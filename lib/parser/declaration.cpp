@@ -63,7 +63,7 @@ inline namespace _v1
                     throw expectation_failure{ message };
                 }
 
-                throw expectation_failure{ message, ctx.begin->string, ctx.begin->range };
+                throw expectation_failure{ message, peek(ctx)->string, peek(ctx)->range };
             }
 
             ret.range = { start, ret.type_expression->range.end() };
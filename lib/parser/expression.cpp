@@ -32,7 +32,7 @@ inline namespace _v1
         return lhs.range == rhs.range && lhs.expression_value == rhs.expression_value;
     }
 
-    expression parse_expression(context & ctx, expression_special_modes mode)
+    expression parse_operand(context & ctx, expression_special_modes mode)
     {
         expression ret;
 
@@ -93,41 +93,8 @@ inline namespace _v1
 
                 else
                 {
-                    throw expectation_failure{ "expression", ctx.begin->string, ctx.begin->range };
-                }
-        }
-
-        if (peek(ctx))
-        {
-            type = peek(ctx)->type;
-            if (is_binary_operator(type) && !(mode == expression_special_modes::assignment && type == lexer::token_type::assign))
-            {
-                auto p1 = precedence({ type, operator_type::binary });
-                auto p2 = ctx.operator_stack.size() ? make_optional(precedence(ctx.operator_stack.back())) : none;
-                while (ctx.operator_stack.empty() || p1 < *p2 || (p1 == *p2 && associativity(type) == assoc::right))
-                {
-                    visit(
-                        [&](const auto & value) -> unit {
-                            ret.range = value.range;
-                            return {};
-                        },
-                        ret.expression_value);
-                    ret.expression_value = parse_binary_expression(ctx, std::move(ret));
-
-                    if (!peek(ctx))
-                    {
-                        break;
-                    }
-
-                    type = peek(ctx)->type;
-                    if (!is_binary_operator(type))
-                    {
-                        break;
-                    }
-
-                    p1 = precedence({ type, operator_type::binary });
+                    throw expectation_failure{ "expression", peek(ctx)->string, peek(ctx)->range };
                 }
-            }
         }
 
         visit(
@@ -140,6 +107,20 @@ inline namespace _v1
         return ret;
     }
 
+    expression parse_expression(context & ctx, expression_special_modes mode)
+    {
+        auto ret = parse_operand(ctx, mode);
+
+        if (auto next = peek(ctx); next && is_binary_operator(next->type)
+            && !(mode == expression_special_modes::assignment && next->type == lexer::token_type::assign)
+            && binds_tighter(next->type, ctx.enclosing_precedence))
+        {
+            return parse_binary_expression(ctx, std::move(ret));
+        }
+
+        return ret;
+    }
+
     void print(const expression & expr, std::ostream & os, print_context ctx)
     {
         os << styles::def << ctx << styles::rule_name << "expression";
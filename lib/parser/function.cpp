@@ -75,14 +75,7 @@ inline namespace _v1
 
         ret.signature = decl ? std::move(*decl) : parse_function_declaration(ctx, mode);
 
-        if (peek(ctx, lexer::token_type::block_value))
-        {
-            ret.body = parse_single_statement_block(ctx);
-        }
-        else
-        {
-            ret.body = parse_block(ctx);
-        }
+        ret.body = parse_function_body(ctx);
 
         ret.range = { ret.signature.range.start(), ret.body->range.end() };
 
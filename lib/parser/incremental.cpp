@@ -0,0 +1,219 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2016-2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+#include <reaver/exception.h>
+
+#include "vapor/parser.h"
+#include "vapor/parser/detail/fields.h"
+#include "vapor/parser/incremental.h"
+
+namespace reaver::vapor::parser
+{
+inline namespace _v1
+{
+    namespace
+    {
+        // moves every position in a subtree by the same distance
+        class position_shift
+        {
+        public:
+            position_shift(std::int64_t delta) : _delta{ delta }
+            {
+            }
+
+            position moved(const position & pos) const
+            {
+                return position(static_cast<std::uint32_t>(pos.offset + _delta), pos.file);
+            }
+
+            void operator()(range_type & range) const
+            {
+                range = { moved(range.start()), moved(range.end()) };
+            }
+
+            void operator()(lexer::token & tok) const
+            {
+                (*this)(tok.range);
+            }
+
+            void operator()(lexer::token_type &) const
+            {
+            }
+
+            template<typename T>
+            void operator()(optional<T> & value) const
+            {
+                if (value)
+                {
+                    (*this)(*value);
+                }
+            }
+
+            template<typename T, typename Allocator>
+            void operator()(std::vector<T, Allocator> & vec) const
+            {
+                for (auto && elem : vec)
+                {
+                    (*this)(elem);
+                }
+            }
+
+            template<typename T>
+            void operator()(recursive_wrapper<T> & value) const
+            {
+                (*this)(*value);
+            }
+
+            template<typename... Ts>
+            void operator()(variant<Ts...> & value) const
+            {
+                visit(
+                    [&](auto & alternative) -> unit {
+                        (*this)(alternative);
+                        return {};
+                    },
+                    value);
+            }
+
+            // a deferred body refers to the tokens of the old text, so it's parsed here, to have something to move
+            void operator()(block & bl) const
+            {
+                if (bl.deferred)
+                {
+                    block contents = parsed(bl);
+                    bl = std::move(contents);
+                }
+
+                _fields(bl);
+            }
+
+            template<typename Node>
+            auto operator()(Node & node) const -> decltype(_detail::fields(node), void())
+            {
+                _fields(node);
+            }
+
+        private:
+            template<typename Node>
+            void _fields(Node & node) const
+            {
+                std::apply([&](auto &... field) { ((*this)(field), ...); }, _detail::fields(node));
+            }
+
+            std::int64_t _delta;
+        };
+
+        // the lexer looks up to two characters past the end of a token, see lexer::relex
+        bool ends_before(const position & end, const lexer::text_edit & edit)
+        {
+            return end.offset + 2 <= edit.begin;
+        }
+    }
+
+    module reparse(const module & previous, const std::u32string & text, const lexer::text_edit & edit, file_id file)
+    {
+        const std::uint32_t inserted_end = edit.begin + edit.replacement.size();
+        if (edit.begin > edit.end || inserted_end > text.size() || edit.begin < previous.range.start().offset)
+        {
+            throw exception(logger::error) << "invalid text edit for a reparse: [" << edit.begin << ", " << edit.end << ") in a text of length "
+                                           << text.size();
+        }
+
+        const std::int64_t delta = static_cast<std::int64_t>(edit.replacement.size()) - (edit.end - edit.begin);
+        auto & old = previous.statements;
+
+        // a statement is kept if the one after it, or the closing bracket of the module, also ends before the edit, since
+        // parsing a statement can involve looking at the tokens that follow it
+        std::size_t kept = 0;
+        while (kept < old.size() && ends_before(kept + 1 < old.size() ? old[kept + 1].range.end() : previous.range.end(), edit))
+        {
+            ++kept;
+        }
+
+        auto memory = std::make_shared<arena>();
+        arena_scope scope{ memory.get() };
+
+        module ret;
+        ret.memory = memory;
+
+        auto start = kept ? old[kept - 1].range.end() : previous.range.start();
+
+        context ctx;
+        ctx.begin = lexer::iterator{ text.begin() + start.offset, text.end(), position(start.offset, file) };
+
+        if (kept)
+        {
+            start = previous.range.start();
+            ret.name = previous.name;
+            std::copy(old.begin(), old.begin() + kept, std::back_inserter(ret.statements));
+        }
+
+        else
+        {
+            start = expect(ctx, lexer::token_type::module).range.start();
+            ret.name = parse_id_expression(ctx);
+            expect(ctx, lexer::token_type::curly_bracket_open);
+        }
+
+        std::size_t next_old = kept;
+        while (!peek(ctx, lexer::token_type::curly_bracket_close))
+        {
+            // past the edit, a statement starting where an old one did is the same statement, moved; so is everything after it
+            auto next = peek(ctx);
+            if (next && next->range.start().offset >= inserted_end)
+            {
+                auto old_offset = next->range.start().offset - delta;
+                while (next_old < old.size() && old[next_old].range.start().offset < old_offset)
+                {
+                    ++next_old;
+                }
+
+                if (next_old < old.size() && old[next_old].range.start().offset == old_offset)
+                {
+                    position_shift shift{ delta };
+                    for (auto i = next_old; i < old.size(); ++i)
+                    {
+                        ret.statements.push_back(old[i]);
+                        if (delta)
+                        {
+                            shift(ret.statements.back());
+                        }
+                    }
+
+                    ret.range = { start, shift.moved(previous.range.end()) };
+                    return ret;
+                }
+            }
+
+            ret.statements.push_back(parse_statement(ctx));
+        }
+
+        auto end = expect(ctx, lexer::token_type::curly_bracket_close).range.end();
+        ret.range = { start, end };
+
+        return ret;
+    }
+}
+}
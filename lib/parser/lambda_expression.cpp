@@ -65,14 +65,7 @@ inline namespace _v1
             ret.return_type = parse_expression(ctx, expression_special_modes::brace);
         }
 
-        if (peek(ctx, lexer::token_type::block_value))
-        {
-            ret.body = parse_single_statement_block(ctx);
-        }
-        else
-        {
-            ret.body = parse_block(ctx);
-        }
+        ret.body = parse_function_body(ctx);
 
         ret.range = { start, ret.body.range.end() };
 
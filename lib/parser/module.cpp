@@ -20,24 +20,292 @@
  *
  **/
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <reaver/future.h>
+
 #include "vapor/parser.h"
 
 namespace reaver::vapor::parser
 {
 inline namespace _v1
 {
+    namespace
+    {
+        // runs shorter than this aren't worth a task of their own
+        constexpr std::size_t min_run_length = 512;
+
+        struct statement_run
+        {
+            lexer::iterator begin;
+            lexer::iterator end;
+        };
+
+        // splits the body of a module, starting after its opening bracket, into runs of whole statements of roughly
+        // `run_length` tokens each
+        // a statement ends with a semicolon outside of any brackets, or, if it's a function or an if statement, with
+        // the closing bracket of its block; that is only a guess, but a wrong one just makes parsing one of the runs fail
+        // returns nothing if the body is not closed, leaving it to the parser to report the error
+        std::vector<statement_run> split_module_body(lexer::iterator begin, lexer::iterator end, std::size_t run_length, lexer::iterator & body_end)
+        {
+            std::vector<statement_run> runs;
+            lexer::iterator run_begin = begin;
+            std::size_t run_tokens = 0;
+
+            std::size_t depth = 0;
+            bool at_statement_start = true;
+            bool ends_with_block = false;
+
+            for (auto it = begin; it != end; ++it, ++run_tokens)
+            {
+                if (at_statement_start)
+                {
+                    if (depth == 0 && it->type == lexer::token_type::curly_bracket_close)
+                    {
+                        if (run_begin != it)
+                        {
+                            runs.push_back({ run_begin, it });
+                        }
+
+                        body_end = it;
+                        return runs;
+                    }
+
+                    if (run_tokens >= run_length)
+                    {
+                        runs.push_back({ run_begin, it });
+                        run_begin = it;
+                        run_tokens = 0;
+                    }
+
+                    at_statement_start = false;
+                    ends_with_block = it->type == lexer::token_type::function || it->type == lexer::token_type::if_;
+                }
+
+                switch (it->type)
+                {
+                    case lexer::token_type::curly_bracket_open:
+                    case lexer::token_type::round_bracket_open:
+                    case lexer::token_type::square_bracket_open:
+                        ++depth;
+                        break;
+
+                    case lexer::token_type::curly_bracket_close:
+                    case lexer::token_type::round_bracket_close:
+                    case lexer::token_type::square_bracket_close:
+                        if (depth == 0)
+                        {
+                            return {};
+                        }
+
+                        if (--depth == 0 && ends_with_block && it->type == lexer::token_type::curly_bracket_close)
+                        {
+                            auto next = it;
+                            ++next;
+                            at_statement_start = next == end || next->type != lexer::token_type::else_;
+                        }
+                        break;
+
+                    // a function with a single expression body ends where the expression does
+                    case lexer::token_type::block_value:
+                        ends_with_block = ends_with_block && depth != 0;
+                        break;
+
+                    case lexer::token_type::semicolon:
+                        at_statement_start = at_statement_start || depth == 0;
+                        break;
+
+                    default:;
+                }
+            }
+
+            return {};
+        }
+
+        // joins neighbouring runs, so that there's at most `count` of them
+        std::vector<statement_run> merge_runs(std::vector<statement_run> runs, std::size_t count)
+        {
+            if (runs.size() <= count)
+            {
+                return runs;
+            }
+
+            std::vector<statement_run> ret;
+            auto per_run = (runs.size() + count - 1) / count;
+            for (std::size_t i = 0; i < runs.size(); i += per_run)
+            {
+                ret.push_back({ runs[i].begin, runs[std::min(i + per_run, runs.size()) - 1].end });
+            }
+
+            return ret;
+        }
+
+        // parses the runs on the default executor; the thread that calls parse() also parses the runs that no one has
+        // taken yet, so this finishes even when called from a thread of a busy, or single-threaded, executor
+        class parallel_statements : public std::enable_shared_from_this<parallel_statements>
+        {
+        public:
+            parallel_statements(std::vector<statement_run> runs, const context & ctx)
+                : _runs{ std::move(runs) }, _memory(_runs.size()), _results(_runs.size()), _context{ ctx }
+            {
+            }
+
+            // returns false if any of the runs failed to parse
+            bool parse(std::size_t helpers)
+            {
+                if (auto executor = default_executor())
+                {
+                    for (std::size_t i = 0; i < helpers; ++i)
+                    {
+                        executor->push([self = shared_from_this()] { self->_work(); });
+                    }
+                }
+
+                _work();
+
+                std::unique_lock<std::mutex> guard{ _lock };
+                _finished.wait(guard, [&] { return _in_flight == 0; });
+                return !_failed;
+            }
+
+            void move_into(module & mod)
+            {
+                for (std::size_t i = 0; i < _runs.size(); ++i)
+                {
+                    std::move(_results[i].begin(), _results[i].end(), std::back_inserter(mod.statements));
+                    if (_memory[i])
+                    {
+                        mod.statement_memory.push_back(std::move(_memory[i]));
+                    }
+                }
+            }
+
+        private:
+            void _work()
+            {
+                std::unique_lock<std::mutex> guard{ _lock };
+
+                while (!_failed && _next < _runs.size())
+                {
+                    auto index = _next++;
+                    ++_in_flight;
+                    guard.unlock();
+
+                    auto memory = _context.allocation == node_allocation::arena ? std::make_shared<arena>() : nullptr;
+                    std::vector<statement> statements;
+                    bool failed = false;
+
+                    try
+                    {
+                        arena_scope scope{ memory.get() };
+
+                        auto ctx = _context;
+                        ctx.begin = _runs[index].begin;
+                        ctx.end = _runs[index].end;
+                        while (peek(ctx))
+                        {
+                            statements.push_back(parse_statement(ctx));
+                        }
+                    }
+
+                    catch (...)
+                    {
+                        failed = true;
+                    }
+
+                    guard.lock();
+                    _results[index] = std::move(statements);
+                    _memory[index] = std::move(memory);
+                    _failed = _failed || failed;
+                    --_in_flight;
+                    _finished.notify_all();
+                }
+            }
+
+            const std::vector<statement_run> _runs;
+            // declared before the results, so that they outlive the nodes allocated from them
+            std::vector<std::shared_ptr<arena>> _memory;
+            std::vector<std::vector<statement>> _results;
+            // the options the runs are parsed with
+            const context _context;
+
+            std::mutex _lock;
+            std::condition_variable _finished;
+            std::size_t _next = 0;
+            std::size_t _in_flight = 0;
+            bool _failed = false;
+        };
+
+        // returns false, leaving the context untouched, if the body couldn't be split or one of its runs failed to
+        // parse; the caller parses the body sequentially then, which also reports the errors in the right order
+        bool parse_statements_in_parallel(context & ctx, module & mod)
+        {
+            // the body is split by walking the lexer iterator, which only points at the current token with nothing read ahead
+            if (ctx.lookahead.ahead())
+            {
+                return false;
+            }
+
+            auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+            lexer::iterator body_end;
+            std::vector<statement_run> runs;
+
+            try
+            {
+                runs = split_module_body(ctx.begin, ctx.end, min_run_length, body_end);
+            }
+
+            // lexing errors are reported by the sequential parser, at the same point they would be without this
+            catch (...)
+            {
+                return false;
+            }
+
+            // small bodies are not worth the tasks
+            if (runs.size() < 2)
+            {
+                return false;
+            }
+
+            runs = merge_runs(std::move(runs), threads * 4);
+            auto helpers = std::min<std::size_t>(threads - 1, runs.size() - 1);
+
+            auto parallel = std::make_shared<parallel_statements>(std::move(runs), ctx);
+            if (!parallel->parse(helpers))
+            {
+                return false;
+            }
+
+            parallel->move_into(mod);
+            ctx.begin = body_end;
+            return true;
+        }
+    }
+
     module parse_module(context & ctx)
     {
+        // the arena is created before the module, so that a partially parsed module is destroyed before it when parsing fails
+        auto memory = ctx.allocation == node_allocation::arena ? std::make_shared<arena>() : nullptr;
+        arena_scope scope{ memory.get() };
+
         module ret;
+        ret.memory = memory;
 
         auto start = expect(ctx, lexer::token_type::module).range.start();
         ret.name = parse_id_expression(ctx);
 
         expect(ctx, lexer::token_type::curly_bracket_open);
 
-        while (!peek(ctx, lexer::token_type::curly_bracket_close))
+        if (ctx.parsing == module_parsing::sequential || !parse_statements_in_parallel(ctx, ret))
         {
-            ret.statements.push_back(parse_statement(ctx));
+            while (!peek(ctx, lexer::token_type::curly_bracket_close))
+            {
+                ret.statements.push_back(parse_statement(ctx));
+            }
         }
 
         auto end = expect(ctx, lexer::token_type::curly_bracket_close).range.end();
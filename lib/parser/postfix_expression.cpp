@@ -102,7 +102,7 @@ inline namespace _v1
             {
                 if (!peek(ctx, closing(*ret.modifier_type)))
                 {
-                    auto old_stack = std::move(ctx.operator_stack);
+                    auto enclosing = std::exchange(ctx.enclosing_precedence, none);
 
                     ret.arguments.push_back(parse_expression(ctx));
                     while (peek(ctx, lexer::token_type::comma))
@@ -111,7 +111,7 @@ inline namespace _v1
                         ret.arguments.push_back(parse_expression(ctx));
                     }
 
-                    ctx.operator_stack = std::move(old_stack);
+                    ctx.enclosing_precedence = enclosing;
                 }
                 end = expect(ctx, closing(*ret.modifier_type)).range.end();
             }
@@ -0,0 +1,490 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2016-2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include "vapor/lexer/interner.h"
+#include "vapor/parser.h"
+#include "vapor/parser/detail/fields.h"
+#include "vapor/parser/serialization.h"
+
+namespace reaver::vapor::parser
+{
+inline namespace _v1
+{
+    namespace
+    {
+        constexpr char format_magic[] = { 'V', 'A', 'S', 'T' };
+        // bump this whenever the layout of any node changes
+        constexpr std::uint64_t format_version = 1;
+
+        class writer
+        {
+        public:
+            void number(std::uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    _body.push_back(static_cast<char>(value | 0x80));
+                    value >>= 7;
+                }
+
+                _body.push_back(static_cast<char>(value));
+            }
+
+            void flag(bool value)
+            {
+                _body.push_back(value);
+            }
+
+            // a zigzag encoded difference from the previous offset
+            void offset(std::uint32_t value)
+            {
+                auto difference = static_cast<std::int64_t>(value) - static_cast<std::int64_t>(std::exchange(_last_offset, value));
+                number(difference < 0 ? (static_cast<std::uint64_t>(-difference) << 1) - 1 : static_cast<std::uint64_t>(difference) << 1);
+            }
+
+            // 0 is the static spelling of the token type, anything else is an index into the table, plus one
+            void string(lexer::token_type type, std::u32string_view str)
+            {
+                if (str == lexer::token_spellings[+type])
+                {
+                    number(0);
+                    return;
+                }
+
+                auto inserted = _indices.emplace(str, _strings.size());
+                if (inserted.second)
+                {
+                    _strings.push_back(str);
+                }
+
+                number(inserted.first->second + 1);
+            }
+
+            std::string finish()
+            {
+                auto body = std::move(_body);
+                _body.clear();
+
+                _body.append(std::begin(format_magic), std::end(format_magic));
+                number(format_version);
+                number(+lexer::token_type::count);
+
+                number(_strings.size());
+                for (auto && str : _strings)
+                {
+                    number(str.size());
+                    for (auto c : str)
+                    {
+                        number(c);
+                    }
+                }
+
+                _body += body;
+                return std::move(_body);
+            }
+
+        private:
+            std::string _body;
+            std::uint32_t _last_offset = 0;
+            std::unordered_map<std::u32string_view, std::size_t> _indices;
+            std::vector<std::u32string_view> _strings;
+        };
+
+        class reader
+        {
+        public:
+            reader(std::string_view data, file_id file) : _begin{ data.data() }, _end{ data.data() + data.size() }, _file{ file }
+            {
+                if (data.size() < sizeof(format_magic) || std::memcmp(data.data(), format_magic, sizeof(format_magic)) != 0)
+                {
+                    throw invalid_serialized_ast{ "not a serialized AST" };
+                }
+                _begin += sizeof(format_magic);
+
+                if (number() != format_version)
+                {
+                    throw invalid_serialized_ast{ "unsupported format version" };
+                }
+
+                if (number() != +lexer::token_type::count)
+                {
+                    throw invalid_serialized_ast{ "written with a different set of token types" };
+                }
+
+                auto count = size();
+                _strings->reserve(count);
+                _ids.resize(count);
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    std::u32string buffer(size(), U'\0');
+                    for (auto && c : buffer)
+                    {
+                        c = static_cast<char32_t>(number());
+                    }
+
+                    _strings->push_back(std::move(buffer));
+                }
+            }
+
+            std::uint64_t number()
+            {
+                std::uint64_t ret = 0;
+
+                for (std::size_t shift = 0; shift < 64; shift += 7)
+                {
+                    if (_begin == _end)
+                    {
+                        throw invalid_serialized_ast{ "unexpected end of data" };
+                    }
+
+                    auto byte = static_cast<unsigned char>(*_begin++);
+                    ret |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+
+                    if (!(byte & 0x80))
+                    {
+                        return ret;
+                    }
+                }
+
+                throw invalid_serialized_ast{ "malformed number" };
+            }
+
+            // a count of things that take at least a byte each
+            std::size_t size()
+            {
+                auto ret = number();
+                if (ret > static_cast<std::size_t>(_end - _begin))
+                {
+                    throw invalid_serialized_ast{ "size out of range" };
+                }
+                return ret;
+            }
+
+            bool flag()
+            {
+                return number() != 0;
+            }
+
+            std::uint32_t offset()
+            {
+                auto encoded = number();
+                auto difference = encoded & 1 ? -static_cast<std::int64_t>((encoded + 1) >> 1) : static_cast<std::int64_t>(encoded >> 1);
+                auto value = static_cast<std::int64_t>(_last_offset) + difference;
+
+                if (value < 0 || value > std::numeric_limits<std::uint32_t>::max())
+                {
+                    throw invalid_serialized_ast{ "offset out of range" };
+                }
+
+                return _last_offset = static_cast<std::uint32_t>(value);
+            }
+
+            void string(lexer::token & tok)
+            {
+                auto index = number();
+
+                if (index == 0)
+                {
+                    tok.string = lexer::token_string::view(lexer::token_spellings[+tok.type]);
+                    if (tok.type == lexer::token_type::identifier)
+                    {
+                        tok.id = lexer::token_spellings[+tok.type];
+                    }
+                    return;
+                }
+
+                if (--index >= _strings->size())
+                {
+                    throw invalid_serialized_ast{ "string index out of range" };
+                }
+
+                // only identifiers are interned, like when they're lexed; the text of anything else refers to the table, which
+                // the loaded tree keeps alive
+                if (tok.type == lexer::token_type::identifier)
+                {
+                    if (!_ids[index])
+                    {
+                        _ids[index] = (*_strings)[index];
+                    }
+                    tok.id = _ids[index];
+                    tok.string = lexer::token_string::view(tok.id.string());
+                    return;
+                }
+
+                tok.string = lexer::token_string::view((*_strings)[index]);
+            }
+
+            file_id file() const
+            {
+                return _file;
+            }
+
+            bool done() const
+            {
+                return _begin == _end;
+            }
+
+            std::shared_ptr<const std::vector<std::u32string>> strings() const
+            {
+                return _strings;
+            }
+
+        private:
+            const char * _begin;
+            const char * _end;
+            file_id _file;
+            std::uint32_t _last_offset = 0;
+
+            // never grows after the table is read, so the tokens can refer to the strings in it
+            std::shared_ptr<std::vector<std::u32string>> _strings = std::make_shared<std::vector<std::u32string>>();
+            std::vector<lexer::identifier_id> _ids;
+        };
+
+        // the nodes are written field by field, in the order they are declared in; loading reads them back in the same order
+
+        void save(writer & w, lexer::token_type type)
+        {
+            w.number(+type);
+        }
+
+        void load(reader & r, lexer::token_type & type)
+        {
+            auto value = r.number();
+            if (value >= +lexer::token_type::count)
+            {
+                throw invalid_serialized_ast{ "token type out of range" };
+            }
+            type = static_cast<lexer::token_type>(value);
+        }
+
+        // the start is stored relative to the previous range written, and the end relative to the start; nodes are written
+        // in the order of the source, more or less, so both are usually short
+        void save(writer & w, const range_type & range)
+        {
+            w.offset(range.start().offset);
+            w.number(range.end() - range.start());
+        }
+
+        void load(reader & r, range_type & range)
+        {
+            auto start = r.offset();
+            auto end = start + r.number();
+            range = { position(start, r.file()), position(static_cast<std::uint32_t>(end), r.file()) };
+        }
+
+        void save(writer & w, const lexer::token & tok)
+        {
+            save(w, tok.type);
+            w.string(tok.type, tok.string);
+            save(w, tok.range);
+        }
+
+        void load(reader & r, lexer::token & tok)
+        {
+            load(r, tok.type);
+            r.string(tok);
+            load(r, tok.range);
+        }
+
+        template<typename T>
+        void save(writer & w, const optional<T> & value)
+        {
+            w.flag(static_cast<bool>(value));
+            if (value)
+            {
+                save(w, *value);
+            }
+        }
+
+        template<typename T>
+        void load(reader & r, optional<T> & value)
+        {
+            if (!r.flag())
+            {
+                value = none;
+                return;
+            }
+
+            T loaded;
+            load(r, loaded);
+            value = std::move(loaded);
+        }
+
+        template<typename T, typename Allocator>
+        void save(writer & w, const std::vector<T, Allocator> & vec)
+        {
+            w.number(vec.size());
+            for (auto && elem : vec)
+            {
+                save(w, elem);
+            }
+        }
+
+        template<typename T, typename Allocator>
+        void load(reader & r, std::vector<T, Allocator> & vec)
+        {
+            auto count = r.size();
+            vec.clear();
+            vec.reserve(count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                vec.emplace_back();
+                load(r, vec.back());
+            }
+        }
+
+        template<typename T>
+        void save(writer & w, const recursive_wrapper<T> & value)
+        {
+            save(w, *value);
+        }
+
+        template<typename T>
+        void load(reader & r, recursive_wrapper<T> & value)
+        {
+            load(r, *value);
+        }
+
+        template<typename... Ts>
+        void save(writer & w, const variant<Ts...> & value)
+        {
+            w.number(value.index());
+            visit(
+                [&](const auto & alternative) -> unit {
+                    save(w, alternative);
+                    return {};
+                },
+                value);
+        }
+
+        template<typename T, typename Variant>
+        void load_alternative(reader & r, Variant & value)
+        {
+            T alternative;
+            load(r, alternative);
+            value = std::move(alternative);
+        }
+
+        template<typename... Ts>
+        void load(reader & r, variant<Ts...> & value)
+        {
+            auto index = r.number();
+            if (index >= sizeof...(Ts))
+            {
+                throw invalid_serialized_ast{ "variant index out of range" };
+            }
+
+            std::size_t i = 0;
+            ((i++ == index ? load_alternative<Ts>(r, value) : void()), ...);
+        }
+
+        using _detail::fields;
+
+        template<typename Node>
+        auto save(writer & w, const Node & node) -> decltype(fields(std::declval<Node &>()), void())
+        {
+            // the fields are only read here
+            std::apply([&](auto &... field) { (save(w, std::as_const(field)), ...); }, fields(const_cast<Node &>(node)));
+        }
+
+        template<typename Node>
+        auto load(reader & r, Node & node) -> decltype(fields(node), void())
+        {
+            std::apply([&](auto &... field) { (load(r, field), ...); }, fields(node));
+        }
+
+        // a deferred body is stored as if it was parsed eagerly
+        void save(writer & w, const block & bl)
+        {
+            auto & contents = parsed(bl);
+            save(w, bl.range);
+            save(w, contents.block_value);
+            save(w, contents.value_expression);
+        }
+
+        void save(writer & w, const module & mod)
+        {
+            save(w, mod.range);
+            save(w, mod.name);
+            save(w, mod.statements);
+        }
+
+        // like parse_module, allocates the nodes of every module from an arena of its own
+        module load_module(reader & r)
+        {
+            auto memory = std::make_shared<arena>();
+            arena_scope scope{ memory.get() };
+
+            module ret;
+            ret.memory = memory;
+
+            load(r, ret.range);
+            load(r, ret.name);
+            load(r, ret.statements);
+
+            return ret;
+        }
+    }
+
+    std::string serialize(const ast & tree)
+    {
+        writer w;
+
+        w.number(std::distance(tree.begin(), tree.end()));
+        for (auto && mod : tree)
+        {
+            save(w, mod);
+        }
+
+        return w.finish();
+    }
+
+    ast deserialize(std::string_view data, file_id file)
+    {
+        reader r{ data, file };
+
+        std::vector<module> modules;
+        auto count = r.size();
+        modules.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            modules.push_back(load_module(r));
+        }
+
+        if (!r.done())
+        {
+            throw invalid_serialized_ast{ "trailing data after the last module" };
+        }
+
+        return ast{ std::move(modules), r.strings() };
+    }
+}
+}
@@ -96,7 +96,7 @@ inline namespace _v1
                 }
 
                 default:
-                    throw expectation_failure{ tpl_type == template_type::named ? "declaration" : "expression", ctx.begin->string, ctx.begin->range };
+                    throw expectation_failure{ tpl_type == template_type::named ? "declaration" : "expression", peek(ctx)->string, peek(ctx)->range };
             }
 
             return ret;
@@ -48,14 +48,14 @@ inline namespace _v1
         if (is_unary_operator(t))
         {
             ret.op = expect(ctx, t);
-            ctx.operator_stack.push_back({ ret.op.type, operator_type::unary });
+            auto enclosing = std::exchange(ctx.enclosing_precedence, unary_operator_precedence);
             ret.operand = parse_expression(ctx);
-            ctx.operator_stack.pop_back();
+            ctx.enclosing_precedence = enclosing;
         }
 
         else
         {
-            throw expectation_failure{ "unary-expression", ctx.begin->string, ctx.begin->range };
+            throw expectation_failure{ "unary-expression", peek(ctx)->string, peek(ctx)->range };
         }
 
         ret.range = { ret.op.range.start(), ret.operand.range.end() };
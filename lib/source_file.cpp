@@ -0,0 +1,116 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <shared_mutex>
+
+#include "vapor/lexer/scan.h"
+#include "vapor/source_file.h"
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    namespace
+    {
+        struct source_files
+        {
+            std::shared_mutex lock;
+            // a deque never moves its elements, so the references handed out stay valid
+            std::deque<source_file> files;
+        };
+
+        source_files & files()
+        {
+            static source_files table;
+            return table;
+        }
+    }
+
+    line_column source_file::locate(std::uint32_t offset) const
+    {
+        std::call_once(_index_built, [&] {
+            _line_starts.push_back(0);
+
+            if (is_utf8())
+            {
+                auto begin = _mapping.data();
+                auto end = begin + _mapping.size();
+
+                std::uint32_t code_points = 0;
+                for (auto newline = lexer::scan::find('\n', begin, end); newline != end; newline = lexer::scan::find('\n', begin, end))
+                {
+                    code_points += lexer::scan::count_code_points(begin, newline + 1);
+                    _line_starts.push_back(code_points);
+                    begin = newline + 1;
+                }
+            }
+
+            else
+            {
+                auto begin = _contents.data();
+                auto end = begin + _contents.size();
+
+                for (auto newline = lexer::scan::find(U'\n', begin, end); newline != end; newline = lexer::scan::find(U'\n', newline + 1, end))
+                {
+                    _line_starts.push_back(newline + 1 - _contents.data());
+                }
+            }
+        });
+
+        auto line = std::upper_bound(_line_starts.begin(), _line_starts.end(), offset) - 1;
+        return { static_cast<std::size_t>(line - _line_starts.begin()) + 1, offset - *line + 1 };
+    }
+
+    const source_file & register_source_file(std::string name, std::u32string contents)
+    {
+        assert(contents.size() <= std::numeric_limits<std::uint32_t>::max());
+
+        auto & table = files();
+        std::unique_lock<std::shared_mutex> lock{ table.lock };
+        // ID 0 is reserved for unknown_file
+        return table.files.emplace_back(table.files.size() + 1, std::move(name), std::move(contents));
+    }
+
+    const source_file & open_source_file(const std::string & path)
+    {
+        mapped_file mapping{ path };
+        assert(mapping.size() <= std::numeric_limits<std::uint32_t>::max());
+
+        auto & table = files();
+        std::unique_lock<std::shared_mutex> lock{ table.lock };
+        return table.files.emplace_back(table.files.size() + 1, path, std::move(mapping));
+    }
+
+    const source_file & get_source_file(file_id id)
+    {
+        assert(id != unknown_file);
+
+        auto & table = files();
+        std::shared_lock<std::shared_mutex> lock{ table.lock };
+        return table.files.at(id - 1);
+    }
+}
+}
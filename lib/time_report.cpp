@@ -0,0 +1,186 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+
+#include <sys/resource.h>
+
+#include "vapor/detail/json.h"
+#include "vapor/time_report.h"
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    namespace
+    {
+        std::atomic<time_report *> active_report{ nullptr };
+
+        double seconds(const timeval & time)
+        {
+            return time.tv_sec + time.tv_usec / 1000000.;
+        }
+
+        // prints the phases from `index` on that are nested at `depth`, along with the ones nested in them; returns the
+        // index of the first phase that isn't
+        std::size_t print_json_phases(std::ostream & os, const std::vector<phase_cost> & phases, std::size_t index, std::size_t depth)
+        {
+            std::string indent(depth * 4 + 4, ' ');
+
+            os << '[';
+            bool first = true;
+            while (index < phases.size() && phases[index].depth == depth)
+            {
+                auto & phase = phases[index];
+
+                os << (first ? "\n" : ",\n") << indent << "{ \"name\": ";
+                _detail::print_json_string(os, phase.name);
+                os << ", \"wall_seconds\": " << phase.wall_seconds << ", \"cpu_seconds\": " << phase.cpu_seconds
+                   << ", \"peak_rss_growth_kb\": " << phase.peak_rss_growth << ", \"allocations\": " << phase.allocations << ", \"phases\": ";
+                index = print_json_phases(os, phases, index + 1, depth + 1);
+                os << " }";
+
+                first = false;
+            }
+
+            if (!first)
+            {
+                os << '\n' << std::string(depth * 4, ' ');
+            }
+            os << ']';
+
+            return index;
+        }
+    }
+
+    std::vector<phase_cost> time_report::phases() const
+    {
+        std::lock_guard<std::mutex> lock{ _lock };
+        return _phases;
+    }
+
+    void time_report::print_table(std::ostream & os) const
+    {
+        auto phases = this->phases();
+
+        std::size_t name_width = 5;
+        for (auto && phase : phases)
+        {
+            name_width = std::max(name_width, phase.depth * 2 + phase.name.size());
+        }
+
+        std::ostringstream table;
+        table << std::fixed << std::left << std::setw(name_width) << "phase" << std::right << std::setw(12) << "wall (s)" << std::setw(12) << "cpu (s)"
+              << std::setw(16) << "peak rss (kB)" << std::setw(14) << "allocations" << '\n';
+
+        for (auto && phase : phases)
+        {
+            table << std::left << std::setw(name_width) << (std::string(phase.depth * 2, ' ') + phase.name) << std::right << std::setprecision(4)
+                  << std::setw(12) << phase.wall_seconds << std::setw(12) << phase.cpu_seconds << std::setw(16) << ('+' + std::to_string(phase.peak_rss_growth))
+                  << std::setw(14) << phase.allocations << '\n';
+        }
+
+        os << table.str();
+    }
+
+    void time_report::print_json(std::ostream & os) const
+    {
+        auto phases = this->phases();
+
+        std::ostringstream json;
+        json << std::setprecision(6) << "{ \"phases\": ";
+        print_json_phases(json, phases, 0, 0);
+        json << " }\n";
+
+        os << json.str();
+    }
+
+    time_report::_snapshot time_report::_take_snapshot() const
+    {
+        rusage usage;
+        ::getrusage(RUSAGE_SELF, &usage);
+
+        return { std::chrono::steady_clock::now(),
+            seconds(usage.ru_utime) + seconds(usage.ru_stime),
+            usage.ru_maxrss,
+            _allocation_counter ? _allocation_counter() : 0 };
+    }
+
+    std::size_t time_report::_start(std::string name)
+    {
+        std::lock_guard<std::mutex> lock{ _lock };
+
+        phase_cost phase;
+        phase.name = std::move(name);
+        phase.depth = _depth++;
+        _phases.push_back(std::move(phase));
+
+        return _phases.size() - 1;
+    }
+
+    void time_report::_finish(std::size_t index, const _snapshot & start)
+    {
+        auto end = _take_snapshot();
+
+        std::lock_guard<std::mutex> lock{ _lock };
+
+        auto & phase = _phases[index];
+        phase.wall_seconds = std::chrono::duration<double>(end.wall - start.wall).count();
+        phase.cpu_seconds = end.cpu_seconds - start.cpu_seconds;
+        phase.peak_rss_growth = end.peak_rss - start.peak_rss;
+        phase.allocations = end.allocations - start.allocations;
+
+        --_depth;
+    }
+
+    time_report * active_time_report()
+    {
+        return active_report.load();
+    }
+
+    void set_active_time_report(time_report * report)
+    {
+        active_report.store(report);
+    }
+
+    phase_timer::phase_timer(std::string name) : _report{ active_time_report() }
+    {
+        if (_report)
+        {
+            _index = _report->_start(std::move(name));
+            // taken last, so that registering the phase isn't counted in it
+            _start = _report->_take_snapshot();
+        }
+    }
+
+    phase_timer::~phase_timer()
+    {
+        if (_report)
+        {
+            _report->_finish(_index, _start);
+        }
+    }
+}
+}
@@ -0,0 +1,178 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+
+#include <cxxabi.h>
+
+#include "vapor/detail/json.h"
+#include "vapor/trace.h"
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    namespace
+    {
+        std::atomic<trace_recorder *> active_recorder{ nullptr };
+
+        // the unqualified name of a node type, like `binary_expression`
+        std::string kind_name(const std::type_info & kind)
+        {
+            int status = 0;
+            std::unique_ptr<char, void (*)(void *)> demangled{ abi::__cxa_demangle(kind.name(), nullptr, nullptr, &status), std::free };
+            std::string name = status == 0 ? demangled.get() : kind.name();
+
+            // the analyzer's types are all in reaver::vapor::analyzer::_v1; keep only the part that tells them apart
+            auto prefix = name.rfind("::", name.find('<'));
+            if (prefix != std::string::npos)
+            {
+                name.erase(0, prefix + 2);
+            }
+
+            return name;
+        }
+    }
+
+    std::vector<trace_span> trace_recorder::spans() const
+    {
+        std::lock_guard<std::mutex> lock{ _lock };
+        return _spans;
+    }
+
+    void trace_recorder::print_json(std::ostream & os) const
+    {
+        auto spans = this->spans();
+
+        std::unordered_map<const std::type_info *, std::string> kinds;
+        std::map<std::thread::id, std::size_t> threads;
+        auto thread_index = [&](std::thread::id id) { return threads.emplace(id, threads.size() + 1).first->second; };
+        auto microseconds = [&](std::chrono::steady_clock::time_point time) { return std::chrono::duration<double, std::micro>(time - _start).count(); };
+
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(3) << "{ \"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+        bool first = true;
+        for (std::size_t id = 0; id < spans.size(); ++id)
+        {
+            auto & span = spans[id];
+
+            auto kind = kinds.find(span.kind);
+            if (kind == kinds.end())
+            {
+                kind = kinds.emplace(span.kind, kind_name(*span.kind)).first;
+            }
+
+            json << (first ? "\n" : ",\n") << "    { \"name\": ";
+            _detail::print_json_string(json, std::string{ span.name } + " " + kind->second);
+            json << ", \"cat\": ";
+            _detail::print_json_string(json, span.name);
+            json << ", \"ph\": \"b\", \"id\": " << id << ", \"pid\": 1, \"tid\": " << thread_index(span.begin_thread) << ", \"ts\": " << microseconds(span.begin)
+                 << ", \"args\": { \"kind\": ";
+            _detail::print_json_string(json, kind->second);
+            if (span.range)
+            {
+                std::ostringstream range;
+                range << *span.range;
+                json << ", \"range\": ";
+                _detail::print_json_string(json, range.str());
+            }
+            json << " } }";
+
+            // a span that never finished is left open, which the viewers show as running until the end of the trace
+            if (span.finished)
+            {
+                json << ",\n    { \"name\": ";
+                _detail::print_json_string(json, std::string{ span.name } + " " + kind->second);
+                json << ", \"cat\": ";
+                _detail::print_json_string(json, span.name);
+                json << ", \"ph\": \"e\", \"id\": " << id << ", \"pid\": 1, \"tid\": " << thread_index(span.end_thread) << ", \"ts\": " << microseconds(span.end)
+                     << " }";
+            }
+
+            first = false;
+        }
+
+        json << "\n] }\n";
+
+        os << json.str();
+    }
+
+    std::size_t trace_recorder::_begin(const char * name, const std::type_info & kind, optional<range_type> range)
+    {
+        trace_span span;
+        span.name = name;
+        span.kind = &kind;
+        span.range = std::move(range);
+        span.begin = std::chrono::steady_clock::now();
+        span.begin_thread = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> lock{ _lock };
+        _spans.push_back(std::move(span));
+        return _spans.size() - 1;
+    }
+
+    void trace_recorder::_end(std::size_t index)
+    {
+        auto end = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock{ _lock };
+
+        auto & span = _spans[index];
+        span.end = end;
+        span.end_thread = std::this_thread::get_id();
+        span.finished = true;
+    }
+
+    trace_recorder * active_trace_recorder()
+    {
+        return active_recorder.load();
+    }
+
+    void set_active_trace_recorder(trace_recorder * recorder)
+    {
+        active_recorder.store(recorder);
+    }
+
+    trace_event::trace_event(const char * name, const std::type_info & kind, optional<range_type> range) : _recorder{ active_trace_recorder() }
+    {
+        if (_recorder)
+        {
+            _index = _recorder->_begin(name, kind, std::move(range));
+        }
+    }
+
+    void trace_event::finish() const
+    {
+        if (_recorder)
+        {
+            _recorder->_end(_index);
+        }
+    }
+}
+}
@@ -0,0 +1,174 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <cassert>
+
+#include "vapor/work_stealing_executor.h"
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    namespace
+    {
+        // the executor the current thread is a worker of, and its index there
+        thread_local work_stealing_executor * current_executor = nullptr;
+        thread_local std::size_t current_index = 0;
+    }
+
+    work_stealing_executor::work_stealing_executor(std::size_t threads)
+    {
+        assert(threads);
+
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            _workers.push_back(std::make_unique<_worker>());
+        }
+
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            _threads.emplace_back([this, i] { _run(i); });
+        }
+    }
+
+    work_stealing_executor::~work_stealing_executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ _sleep_lock };
+            _stop = true;
+        }
+        _wake.notify_all();
+
+        for (auto && thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    void work_stealing_executor::push(function<void()> f)
+    {
+        // counted before it's queued, so that a worker that takes it right away can't bring the count below zero
+        _pending.fetch_add(1);
+
+        if (current_executor == this)
+        {
+            auto & worker = *_workers[current_index];
+            std::lock_guard<std::mutex> lock{ worker.lock };
+            worker.tasks.push_back(std::move(f));
+            _pushed_locally.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        else
+        {
+            std::lock_guard<std::mutex> lock{ _shared_lock };
+            _shared_tasks.push_back(std::move(f));
+            _pushed_externally.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // a worker counts itself as sleeping before it checks for pending tasks for the last time, so either it sees this
+        // task, or this sees it and wakes it up
+        if (_sleeping.load())
+        {
+            {
+                std::lock_guard<std::mutex> lock{ _sleep_lock };
+            }
+            _wake.notify_one();
+        }
+    }
+
+    work_stealing_executor::statistics work_stealing_executor::get_statistics() const
+    {
+        statistics ret;
+        ret.pushed_locally = _pushed_locally.load(std::memory_order_relaxed);
+        ret.pushed_externally = _pushed_externally.load(std::memory_order_relaxed);
+        ret.stolen = _stolen.load(std::memory_order_relaxed);
+        return ret;
+    }
+
+    bool work_stealing_executor::_try_pop(std::size_t index, function<void()> & task)
+    {
+        {
+            auto & own = *_workers[index];
+            std::lock_guard<std::mutex> lock{ own.lock };
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{ _shared_lock };
+            if (!_shared_tasks.empty())
+            {
+                task = std::move(_shared_tasks.front());
+                _shared_tasks.pop_front();
+                return true;
+            }
+        }
+
+        for (std::size_t i = 1; i < _workers.size(); ++i)
+        {
+            auto & victim = *_workers[(index + i) % _workers.size()];
+            std::lock_guard<std::mutex> lock{ victim.lock };
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                _stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void work_stealing_executor::_run(std::size_t index)
+    {
+        current_executor = this;
+        current_index = index;
+
+        while (true)
+        {
+            function<void()> task;
+            if (_try_pop(index, task))
+            {
+                _pending.fetch_sub(1);
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{ _sleep_lock };
+            _sleeping.fetch_add(1);
+            _wake.wait(lock, [&] { return _stop || _pending.load(); });
+            _sleeping.fetch_sub(1);
+
+            // the tasks that are still queued are finished before the workers go away
+            if (_stop && !_pending.load())
+            {
+                return;
+            }
+        }
+    }
+}
+}
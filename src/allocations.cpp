@@ -0,0 +1,73 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "allocations.h"
+
+namespace
+{
+std::atomic<std::size_t> allocations{ 0 };
+std::atomic<std::size_t> allocated_bytes{ 0 };
+}
+
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    // the cost of counting is two relaxed increments per allocation
+    std::size_t allocation_count()
+    {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+    std::size_t allocated_byte_count()
+    {
+        return allocated_bytes.load(std::memory_order_relaxed);
+    }
+}
+}
+
+void * operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (auto ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
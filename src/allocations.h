@@ -0,0 +1,37 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#pragma once
+
+#include <cstddef>
+
+// the replacement global operator new in allocations.cpp counts every allocation of the process; it is linked into the
+// driver, for --time-report, and into the benchmark binary, but not into the library, so it never replaces the allocator
+// of anything else that uses it
+namespace reaver::vapor
+{
+inline namespace _v1
+{
+    std::size_t allocation_count();
+    std::size_t allocated_byte_count();
+}
+}
@@ -21,14 +21,23 @@
  **/
 
 #include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
 
 #include <fstream>
+#include <iostream>
+#include <memory>
 
 #include "vapor/analyzer.h"
 #include "vapor/codegen.h"
 #include "vapor/lexer.h"
 #include "vapor/parser.h"
+#include "vapor/source_file.h"
+#include "vapor/time_report.h"
+#include "vapor/trace.h"
 #include "vapor/utf.h"
+#include "vapor/work_stealing_executor.h"
+
+#include "allocations.h"
 
 std::u32string program = UR"program(module hello_world
 {
@@ -60,50 +69,191 @@ std::u32string program = UR"program(module hello_world
     };
 })program";
 
-int main() try
+int main(int argc, char ** argv) try
 {
-    // force a single thread of execution
-    reaver::default_executor(reaver::make_executor<reaver::thread_pool>(1));
+    namespace po = boost::program_options;
+
+    po::options_description options("Options");
+    options.add_options()("help,h", "print this message")(
+        "lexer-engine", po::value<std::string>()->default_value("threaded"), "lexer engine to use: `threaded`, `synchronous` or `parallel`")(
+        "jobs,j", po::value<std::size_t>()->default_value(1), "number of threads to analyze and simplify the program on")(
+        "executor", po::value<std::string>()->default_value("thread_pool"), "executor to run the threads with: `thread_pool` or `work_stealing`")(
+        "input", po::value<std::string>(), "the .vprl file to compile; the built-in example is compiled if not given")(
+        "ast-cache", po::value<std::string>(), "directory to keep parsed ASTs in; unchanged inputs are loaded from it instead of being parsed")(
+        "time-report", po::value<std::string>()->implicit_value("table"), "print the time, memory and allocations spent in every phase: as a `table` or as `json`")(
+        "time-report-output", po::value<std::string>(), "file to write the time report to, instead of the standard output")(
+        "trace", po::value<std::string>(), "file to write a Chrome trace of the analysis and simplification of every node to");
+
+    po::positional_options_description positional;
+    positional.add("input", 1);
+
+    po::variables_map variables;
+    po::store(po::command_line_parser(argc, argv).options(options).positional(positional).run(), variables);
+    po::notify(variables);
+
+    if (variables.count("help"))
+    {
+        std::cout << options;
+        return 0;
+    }
+
+    auto engine_name = variables["lexer-engine"].as<std::string>();
+    if (engine_name != "threaded" && engine_name != "synchronous" && engine_name != "parallel")
+    {
+        reaver::logger::dlog(reaver::logger::error) << "unknown lexer engine: " << engine_name;
+        return 1;
+    }
+    auto engine = engine_name == "threaded" ? reaver::vapor::lexer::engine::threaded
+                                            : engine_name == "synchronous" ? reaver::vapor::lexer::engine::synchronous : reaver::vapor::lexer::engine::parallel;
+
+    auto jobs = variables["jobs"].as<std::size_t>();
+    if (jobs == 0)
+    {
+        reaver::logger::dlog(reaver::logger::error) << "the number of jobs must be at least 1";
+        return 1;
+    }
+
+    auto executor_name = variables["executor"].as<std::string>();
+    if (executor_name != "thread_pool" && executor_name != "work_stealing")
+    {
+        reaver::logger::dlog(reaver::logger::error) << "unknown executor: " << executor_name;
+        return 1;
+    }
+
+    reaver::vapor::time_report report{ reaver::vapor::allocation_count };
+    if (variables.count("time-report"))
+    {
+        auto format = variables["time-report"].as<std::string>();
+        if (format != "table" && format != "json")
+        {
+            reaver::logger::dlog(reaver::logger::error) << "unknown time report format: " << format;
+            return 1;
+        }
+
+        reaver::vapor::set_active_time_report(&report);
+    }
+
+    reaver::vapor::trace_recorder trace;
+    if (variables.count("trace"))
+    {
+        reaver::vapor::set_active_trace_recorder(&trace);
+    }
+
+    if (executor_name == "work_stealing")
+    {
+        reaver::default_executor(std::make_shared<reaver::vapor::work_stealing_executor>(jobs));
+    }
+
+    else
+    {
+        reaver::default_executor(reaver::make_executor<reaver::thread_pool>(jobs));
+    }
+
+    // files given on the command line are lexed straight from UTF-8
+    auto & source = variables.count("input") ? reaver::vapor::open_source_file(variables["input"].as<std::string>())
+                                             : reaver::vapor::register_source_file("hello_world.vprl", std::move(program));
 
     reaver::logger::dlog() << "Input:";
-    reaver::logger::dlog() << reaver::vapor::utf8(program);
+    reaver::logger::dlog() << (source.is_utf8() ? std::string{ source.utf8_contents() } : reaver::vapor::utf8(source.contents()));
     reaver::logger::dlog();
 
-    reaver::logger::dlog() << "Tokens:";
-    reaver::vapor::lexer::iterator iterator{ program.begin(), program.end() };
-    for (auto it = iterator; it; ++it)
+    std::unique_ptr<reaver::vapor::parser::ast_cache> cache;
+    if (variables.count("ast-cache"))
     {
-        reaver::logger::dlog() << *it;
+        cache = std::make_unique<reaver::vapor::parser::ast_cache>(variables["ast-cache"].as<std::string>());
     }
-    reaver::logger::dlog();
 
-    reaver::logger::default_logger().sync();
+    auto ast = [&]() -> reaver::vapor::parser::ast {
+        // a cached AST is loaded without lexing the file at all
+        if (cache)
+        {
+            reaver::vapor::phase_timer timer{ "ast cache load" };
+            if (auto cached = cache->load(source))
+            {
+                reaver::logger::dlog() << "AST (from the cache):";
+                return std::move(*cached);
+            }
+        }
+
+        reaver::vapor::lexer::iterator iterator{ source, engine, reaver::vapor::lexer::handoff_mode::chunked };
+        {
+            // the iterator keeps the tokens alive, so the walks after this one don't lex again
+            reaver::vapor::phase_timer timer{ "lex" };
+            for (auto it = iterator; it; ++it)
+            {
+            }
+        }
+
+        reaver::logger::dlog() << "Tokens:";
+        for (auto it = iterator; it; ++it)
+        {
+            reaver::logger::dlog() << *it;
+        }
+        reaver::logger::dlog();
 
-    reaver::logger::dlog() << "AST:";
-    reaver::vapor::parser::ast ast{ iterator };
+        reaver::logger::default_logger().sync();
+
+        reaver::logger::dlog() << "AST:";
+        auto parsed = [&] {
+            reaver::vapor::phase_timer timer{ "parse" };
+            return reaver::vapor::parser::ast{ iterator };
+        }();
+
+        // a cache that can't be written to only makes the next compilation slower, so it doesn't stop this one
+        if (cache)
+        {
+            reaver::vapor::phase_timer timer{ "ast cache store" };
+            try
+            {
+                cache->store(source, parsed);
+            }
+
+            catch (reaver::exception & e)
+            {
+                reaver::logger::dlog(reaver::logger::warning) << "the AST was not cached: " << e.what();
+            }
+        }
+
+        return parsed;
+    }();
     reaver::logger::dlog() << ast;
 
     reaver::logger::default_logger().sync();
 
     reaver::logger::dlog() << "Analyzed AST:";
-    reaver::vapor::analyzer::ast analyzed_ast{ std::move(ast) };
-    reaver::logger::dlog() << std::ref(analyzed_ast);
+    auto analyzed_ast = [&] {
+        reaver::vapor::phase_timer timer{ "analyze" };
+        return std::make_unique<reaver::vapor::analyzer::ast>(std::move(ast));
+    }();
+    reaver::logger::dlog() << std::ref(*analyzed_ast);
 
     reaver::logger::default_logger().sync();
 
     reaver::logger::dlog() << "Simplified AAST:";
-    analyzed_ast.simplify();
-    reaver::logger::dlog() << std::ref(analyzed_ast);
+    {
+        reaver::vapor::phase_timer timer{ "simplify" };
+        analyzed_ast->simplify();
+    }
+    reaver::logger::dlog() << std::ref(*analyzed_ast);
 
     reaver::logger::default_logger().sync();
 
-    auto ir = analyzed_ast.codegen_ir();
+    auto ir = [&] {
+        reaver::vapor::phase_timer timer{ "codegen_ir" };
+        return analyzed_ast->codegen_ir();
+    }();
 
-    reaver::vapor::codegen::result generated_ir{ ir, reaver::vapor::codegen::make_printer() };
+    auto generated_ir = [&] {
+        reaver::vapor::phase_timer timer{ "printer" };
+        return reaver::vapor::codegen::result{ ir, reaver::vapor::codegen::make_printer() };
+    }();
     reaver::logger::dlog() << "Generated IR:";
     reaver::logger::dlog() << generated_ir;
 
-    reaver::vapor::codegen::result generated_code{ ir, reaver::vapor::codegen::make_llvm_ir() };
+    auto generated_code = [&] {
+        reaver::vapor::phase_timer timer{ "llvm_ir" };
+        return reaver::vapor::codegen::result{ ir, reaver::vapor::codegen::make_llvm_ir() };
+    }();
     reaver::logger::dlog() << "Generated LLVM IR:";
     reaver::logger::dlog() << generated_code;
 
@@ -112,6 +262,36 @@ int main() try
     out << generated_code;
 
     reaver::logger::default_logger().sync();
+
+    if (variables.count("trace"))
+    {
+        reaver::vapor::set_active_trace_recorder(nullptr);
+
+        std::ofstream file{ variables["trace"].as<std::string>(), std::ios::trunc | std::ios::out };
+        trace.print_json(file);
+    }
+
+    if (variables.count("time-report"))
+    {
+        reaver::vapor::set_active_time_report(nullptr);
+
+        std::ofstream file;
+        if (variables.count("time-report-output"))
+        {
+            file.open(variables["time-report-output"].as<std::string>(), std::ios::trunc | std::ios::out);
+        }
+        auto & os = variables.count("time-report-output") ? static_cast<std::ostream &>(file) : std::cout;
+
+        if (variables["time-report"].as<std::string>() == "json")
+        {
+            report.print_json(os);
+        }
+
+        else
+        {
+            report.print_table(os);
+        }
+    }
 }
 
 catch (reaver::exception & e)
@@ -35,7 +35,7 @@ inline namespace _v1
     auto parse(std::u32string program, F && parser)
     {
         parser::context ctx;
-        ctx.begin = lexer::iterator{ program.begin(), program.end() };
+        ctx.begin = lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous };
 
         return parser(ctx);
     }
@@ -57,6 +57,25 @@ MAYFLY_ADD_TESTCASE("init and get", [] {
     MAYFLY_REQUIRE(s.get_or_init(U"another", [&] { return std::move(another); }) == another_ptr);
 });
 
+MAYFLY_ADD_TESTCASE("lookup by identifier ID", [] {
+    scope s{};
+
+    std::u32string program = U"present absent";
+    std::vector<lexer::token> tokens;
+    std::copy(lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous }, lexer::iterator{}, std::back_inserter(tokens));
+    MAYFLY_REQUIRE(tokens.size() == 2);
+
+    auto present = make_symbol(tokens[0].id);
+    auto present_ptr = present.get();
+    MAYFLY_REQUIRE(s.init(tokens[0].id, std::move(present)));
+
+    MAYFLY_CHECK(s.get(U"present") == present_ptr);
+    MAYFLY_CHECK(s.get(tokens[0].id) == present_ptr);
+    MAYFLY_CHECK(present_ptr->get_name() == U"present");
+    MAYFLY_CHECK(present_ptr->get_id() == tokens[0].id);
+    MAYFLY_CHECK(!s.try_get(tokens[1].id));
+});
+
 MAYFLY_ADD_TESTCASE("get_future", [] {
     scope s{};
 
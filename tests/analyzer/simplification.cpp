@@ -0,0 +1,108 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <regex>
+#include <sstream>
+#include <string>
+
+#include <reaver/future.h>
+#include <reaver/mayfly.h>
+
+#include "helpers.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::analyzer;
+
+namespace
+{
+// every statement after ackermann can only be folded once the ones it uses were, and the calls are folded from the body of
+// ackermann, which is being simplified at the same time, so most of the folds happen in later runs of the module
+const std::u32string program = UR"program(module worklist
+{
+    let int32 = sized_int(32);
+
+    let mn = struct { let m : int32; let n : int32; };
+
+    function ackermann(args : mn) -> int32
+    {
+        if (args.m == 0)
+        {
+            return args.n + 1;
+        }
+
+        if (args.n == 0)
+        {
+            return ackermann(args{ .m = .m - 1, .n = 1 });
+        }
+
+        return ackermann(args{ .m = .m - 1, .n = ackermann(args{ .n = .n - 1 }) });
+    }
+
+    let first = ackermann(mn{ 1, 2 });
+    let second = ackermann(mn{ 1, first });
+    let third = ackermann(mn{ 2, second - first });
+
+    let entry = λ(arg : int32) -> int32
+    {
+        let constant_foldable = ackermann(mn{ third - 5, 1 });
+        let non_constant_foldable = ackermann(mn{ arg, arg + 1 });
+
+        return constant_foldable - non_constant_foldable;
+    };
+})program";
+
+// the printed tree, without the addresses of the nodes, which differ between the runs
+std::string analyze_and_simplify(simplification_reruns reruns, std::size_t threads)
+{
+    auto previous = reaver::default_executor();
+    reaver::default_executor(reaver::make_executor<reaver::thread_pool>(threads));
+
+    std::stringstream printed;
+    {
+        analyzer::ast tree{ parser::ast{ lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous } } };
+        tree.simplify(reruns);
+        printed << std::ref(tree);
+    }
+
+    reaver::default_executor(previous);
+
+    return std::regex_replace(printed.str(), std::regex{ "0x[0-9a-f]+" }, "");
+}
+}
+
+MAYFLY_BEGIN_SUITE("analyzer");
+MAYFLY_BEGIN_SUITE("simplification");
+
+MAYFLY_ADD_TESTCASE("rerunning only the affected statements reaches the same result as rerunning all of them", [] {
+    auto expected = analyze_and_simplify(simplification_reruns::all, 1);
+
+    MAYFLY_REQUIRE(analyze_and_simplify(simplification_reruns::affected, 1) == expected);
+
+    // on more threads, a call can be folded before the body of the function it calls is done being simplified
+    for (std::size_t run = 0; run < 8; ++run)
+    {
+        MAYFLY_REQUIRE(analyze_and_simplify(simplification_reruns::affected, 4) == expected);
+    }
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -0,0 +1,118 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+
+#include <reaver/future.h>
+#include <reaver/mayfly.h>
+
+#include "helpers.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::analyzer;
+
+namespace
+{
+// every copy asks for the same sized integer type and folds its own calls, so the copies race on all the caches that
+// the analysis and the simplification share; `$` is replaced with the number of the copy
+const std::u32string copy_template = UR"program(
+    let int32_$ = sized_int(32);
+    let mn_$ = struct { let m : int32_$; let n : int32_$; };
+
+    function ackermann_$(args : mn_$) -> int32_$
+    {
+        if (args.m == 0)
+        {
+            return args.n + 1;
+        }
+
+        if (args.n == 0)
+        {
+            return ackermann_$(args{ .m = .m - 1, .n = 1 });
+        }
+
+        return ackermann_$(args{ .m = .m - 1, .n = ackermann_$(args{ .n = .n - 1 }) });
+    }
+
+    let value_$ = ackermann_$(mn_${ 1, 2 });
+)program";
+
+std::u32string make_program(std::size_t copies)
+{
+    std::u32string program = U"module stress\n{";
+
+    for (std::size_t i = 0; i < copies; ++i)
+    {
+        auto number = utf32(std::to_string(i));
+        for (auto c : copy_template)
+        {
+            if (c == U'$')
+            {
+                program += number;
+                continue;
+            }
+
+            program += c;
+        }
+    }
+
+    program += U"}\n";
+    return program;
+}
+
+// the printed tree, without the addresses of the nodes, which differ between the runs
+std::string analyze_and_simplify(const std::u32string & program, std::size_t threads)
+{
+    auto previous = reaver::default_executor();
+    reaver::default_executor(reaver::make_executor<reaver::thread_pool>(threads));
+
+    std::stringstream printed;
+    {
+        analyzer::ast tree{ parser::ast{ lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous } } };
+        tree.simplify();
+        printed << std::ref(tree);
+    }
+
+    reaver::default_executor(previous);
+
+    return std::regex_replace(printed.str(), std::regex{ "0x[0-9a-f]+" }, "");
+}
+}
+
+MAYFLY_BEGIN_SUITE("analyzer");
+MAYFLY_BEGIN_SUITE("threads");
+
+MAYFLY_ADD_TESTCASE("a large module is analyzed and simplified the same way on many threads", [] {
+    auto program = make_program(32);
+    auto expected = analyze_and_simplify(program, 1);
+
+    for (std::size_t run = 0; run < 8; ++run)
+    {
+        MAYFLY_REQUIRE(analyze_and_simplify(program, 8) == expected);
+    }
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
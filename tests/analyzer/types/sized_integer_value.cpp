@@ -0,0 +1,89 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <limits>
+#include <sstream>
+
+#include <reaver/mayfly.h>
+
+#include "vapor/analyzer/types/sized_integer_value.h"
+
+using namespace reaver::vapor::analyzer;
+using boost::multiprecision::cpp_int;
+
+MAYFLY_BEGIN_SUITE("analyzer");
+MAYFLY_BEGIN_SUITE("types");
+MAYFLY_BEGIN_SUITE("sized integer value");
+
+MAYFLY_ADD_TESTCASE("small arithmetic", [] {
+    sized_integer_value lhs{ 12 };
+    sized_integer_value rhs{ -5 };
+
+    MAYFLY_CHECK((lhs + rhs).is_small());
+    MAYFLY_CHECK(lhs + rhs == sized_integer_value{ 7 });
+    MAYFLY_CHECK(lhs - rhs == sized_integer_value{ 17 });
+    MAYFLY_CHECK(lhs * rhs == sized_integer_value{ -60 });
+    MAYFLY_CHECK(rhs < lhs);
+    MAYFLY_CHECK(!(lhs <= rhs));
+});
+
+MAYFLY_ADD_TESTCASE("overflow promotes", [] {
+    sized_integer_value max{ std::numeric_limits<std::int64_t>::max() };
+    sized_integer_value min{ std::numeric_limits<std::int64_t>::min() };
+
+    auto sum = max + sized_integer_value{ 1 };
+    MAYFLY_REQUIRE(!sum.is_small());
+    MAYFLY_CHECK(sum.to_cpp_int() == cpp_int{ std::numeric_limits<std::int64_t>::max() } + 1);
+
+    auto difference = min - sized_integer_value{ 1 };
+    MAYFLY_REQUIRE(!difference.is_small());
+    MAYFLY_CHECK(difference.to_cpp_int() == cpp_int{ std::numeric_limits<std::int64_t>::min() } - 1);
+
+    auto product = max * max;
+    MAYFLY_REQUIRE(!product.is_small());
+    MAYFLY_CHECK(product.to_cpp_int() == cpp_int{ max.to_cpp_int() * max.to_cpp_int() });
+
+    MAYFLY_CHECK(max < sum);
+    MAYFLY_CHECK(difference < min);
+});
+
+MAYFLY_ADD_TESTCASE("values that fit are kept small", [] {
+    sized_integer_value max{ std::numeric_limits<std::int64_t>::max() };
+
+    auto back = (max + sized_integer_value{ 1 }) - sized_integer_value{ 1 };
+    MAYFLY_CHECK(back.is_small());
+    MAYFLY_CHECK(back == max);
+    MAYFLY_CHECK(hash_value(back) == hash_value(max));
+
+    MAYFLY_CHECK(sized_integer_value{ cpp_int{ 42 } }.is_small());
+    MAYFLY_CHECK(!sized_integer_value{ cpp_int{ cpp_int{ 1 } << 64 } }.is_small());
+});
+
+MAYFLY_ADD_TESTCASE("printing", [] {
+    std::ostringstream os;
+    os << sized_integer_value{ -5 } << ' ' << sized_integer_value{ cpp_int{ cpp_int{ 1 } << 64 } };
+    MAYFLY_CHECK(os.str() == "-5 18446744073709551616");
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -0,0 +1,55 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <reaver/mayfly.h>
+
+#include <string>
+#include <vector>
+
+#include "helpers.h"
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor::lexer;
+
+MAYFLY_BEGIN_SUITE("lexer");
+MAYFLY_BEGIN_SUITE("comments");
+
+MAYFLY_ADD_TESTCASE("line comment", test(U"foo // bar * / baz\nqux", { { token_type::identifier, U"foo", { 0, 3 } }, { token_type::identifier, U"qux", { 19, 22 } } }));
+
+MAYFLY_ADD_TESTCASE("line comment at the end", test(U"foo // bar", { { token_type::identifier, U"foo", { 0, 3 } } }));
+
+MAYFLY_ADD_TESTCASE("block comment",
+    test(U"foo /* a * b / c **/ bar /**/ baz", { { token_type::identifier, U"foo", { 0, 3 } }, { token_type::identifier, U"bar", { 21, 24 } }, { token_type::identifier, U"baz", { 30, 33 } } }));
+
+MAYFLY_ADD_TESTCASE("multiline block comment", test(U"/* foo\n * bar\n */ baz", { { token_type::identifier, U"baz", { 18, 21 } } }));
+
+MAYFLY_ADD_TESTCASE("unterminated block comment", [] {
+    for (std::u32string program : { U"foo /* bar", U"foo /* bar *", U"foo /*/" })
+    {
+        std::vector<token> tokens;
+        MAYFLY_CHECK_THROWS_TYPE(
+            unterminated_comment, std::copy(iterator{ program.begin(), program.end(), engine::synchronous }, iterator{}, std::back_inserter(tokens)));
+    }
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -34,14 +34,20 @@ namespace vapor
     {
         inline namespace _v1
         {
-            auto test(std::u32string program, std::vector<token> expected)
+            inline auto test(std::u32string program, std::vector<token> expected)
             {
                 return [program = std::move(program), expected = std::move(expected)]()
                 {
-                    std::vector<token> generated;
-                    std::copy(iterator{ program.begin(), program.end() }, iterator{}, std::back_inserter(generated));
+                    for (auto eng : { engine::threaded, engine::synchronous, engine::parallel })
+                    {
+                        for (auto mode : { handoff_mode::per_token, handoff_mode::chunked })
+                        {
+                            std::vector<token> generated;
+                            std::copy(iterator{ program.begin(), program.end(), eng, mode }, iterator{}, std::back_inserter(generated));
 
-                    MAYFLY_REQUIRE(expected == generated);
+                            MAYFLY_REQUIRE(expected == generated);
+                        }
+                    }
                 };
             }
         }
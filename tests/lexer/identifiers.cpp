@@ -0,0 +1,125 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <reaver/mayfly.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "helpers.h"
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::lexer;
+
+MAYFLY_BEGIN_SUITE("lexer");
+MAYFLY_BEGIN_SUITE("identifiers");
+
+MAYFLY_ADD_TESTCASE("identifiers and keywords",
+    test(U"foo bar let foo",
+        { { token_type::identifier, U"foo", { 0, 3 } },
+            { token_type::identifier, U"bar", { 4, 7 } },
+            { token_type::let, U"let", { 8, 11 } },
+            { token_type::identifier, U"foo", { 12, 15 } } }));
+
+MAYFLY_ADD_TESTCASE("identifiers are interned", [] {
+    std::u32string first = U"foo bar";
+    std::u32string second = U"bar + foo";
+
+    std::vector<token> tokens;
+    std::copy(iterator{ first.begin(), first.end(), engine::synchronous }, iterator{}, std::back_inserter(tokens));
+    std::copy(iterator{ second.begin(), second.end(), engine::synchronous }, iterator{}, std::back_inserter(tokens));
+
+    MAYFLY_REQUIRE(tokens.size() == 5);
+    MAYFLY_CHECK(tokens[0].string.data() == tokens[4].string.data());
+    MAYFLY_CHECK(tokens[1].string.data() == tokens[2].string.data());
+    MAYFLY_CHECK(tokens[0].string.data() != first.data());
+    MAYFLY_CHECK(intern(U"foo").data() == tokens[0].string.data());
+
+    MAYFLY_CHECK(tokens[0].id == tokens[4].id);
+    MAYFLY_CHECK(tokens[0].id != tokens[1].id);
+    MAYFLY_CHECK(tokens[0].id == identifier_id{ U"foo" });
+    MAYFLY_CHECK(tokens[0].id.string().data() == tokens[0].string.data());
+    MAYFLY_CHECK(!tokens[3].id);
+});
+
+MAYFLY_ADD_TESTCASE("integers are not interned", [] {
+    std::vector<token> tokens;
+    {
+        std::u32string source = U"1234567 1234567";
+        std::copy(iterator{ source.begin(), source.end(), engine::synchronous }, iterator{}, std::back_inserter(tokens));
+    }
+
+    // the source is gone by now
+    MAYFLY_REQUIRE(tokens.size() == 2);
+    MAYFLY_CHECK(tokens[0].string.str() == U"1234567");
+    MAYFLY_CHECK(tokens[1].string.str() == U"1234567");
+    MAYFLY_CHECK(tokens[0].string.data() != tokens[1].string.data());
+    MAYFLY_CHECK(tokens[0].string.data() != intern(U"1234567").data());
+});
+
+MAYFLY_ADD_TESTCASE("identifier IDs", [] {
+    MAYFLY_CHECK(!identifier_id{});
+    MAYFLY_CHECK(identifier_id{ U"" } == identifier_id{});
+    MAYFLY_CHECK(identifier_id{}.string().empty());
+
+    // enough strings to need a couple of segments of the table, from multiple threads at once
+    std::vector<std::u32string> strings;
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+        strings.push_back(U"identifier-ids-" + utf32(std::to_string(i)));
+    }
+
+    std::vector<identifier_id> ids[4];
+    std::vector<std::thread> threads;
+    for (auto && thread_ids : ids)
+    {
+        threads.emplace_back([&] {
+            for (auto && str : strings)
+            {
+                thread_ids.emplace_back(str);
+            }
+        });
+    }
+
+    for (auto && thread : threads)
+    {
+        thread.join();
+    }
+
+    for (std::size_t i = 0; i < strings.size(); ++i)
+    {
+        MAYFLY_CHECK(ids[0][i].string() == strings[i]);
+        MAYFLY_CHECK(ids[0][i].string().data() == intern(strings[i]).data());
+
+        for (auto && thread_ids : ids)
+        {
+            MAYFLY_CHECK(thread_ids[i] == ids[0][i]);
+        }
+    }
+});
+
+MAYFLY_ADD_TESTCASE("symbols", test(U"|= ||", { { token_type::bitwise_or_assignment, U"|=", { 0, 2 } }, { token_type::logical_or, U"||", { 3, 5 } } }));
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
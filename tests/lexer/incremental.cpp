@@ -0,0 +1,146 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <reaver/mayfly.h>
+
+#include <string>
+#include <vector>
+
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::lexer;
+
+namespace
+{
+std::vector<token> lex(const std::u32string & program)
+{
+    std::vector<token> tokens;
+    std::copy(iterator{ program.begin(), program.end(), engine::synchronous }, iterator{}, std::back_inserter(tokens));
+    return tokens;
+}
+
+const std::u32string program = UR"(module foo
+{
+    let a = "a string"; // a comment
+    let b = λ(x : int32) -> int32 => x * 2;
+    /* a block comment */
+    let c = a - b;
+}
+)";
+
+// applies the edit to `program`, and checks the result against lexing the edited text from scratch
+token_change check_edit(std::uint32_t offset, std::uint32_t removed, std::u32string replacement)
+{
+    text_edit edit{ offset, offset + removed, std::move(replacement) };
+
+    auto text = program;
+    apply_edit(text, edit);
+
+    auto tokens = lex(program);
+    auto change = relex(tokens, text, edit);
+    MAYFLY_CHECK(tokens == lex(text));
+
+    return change;
+}
+}
+
+MAYFLY_BEGIN_SUITE("lexer");
+MAYFLY_BEGIN_SUITE("incremental");
+
+MAYFLY_ADD_TESTCASE("renaming an identifier", [] {
+    auto offset = program.find(U"a = ");
+    auto change = check_edit(offset, 1, U"abc");
+
+    // `let` is relexed too, as it could have been followed by something that changes how it's lexed
+    MAYFLY_CHECK(change.first == 3);
+    MAYFLY_CHECK(change.removed == 2);
+    MAYFLY_CHECK(change.inserted == 2);
+});
+
+MAYFLY_ADD_TESTCASE("merging and splitting tokens", [] {
+    auto minus = program.find(U" - b");
+    check_edit(minus, 1, U"");
+    check_edit(minus + 1, 1, U"->");
+    check_edit(minus + 2, 1, U">");
+    check_edit(program.find(U"let b"), 0, U"x");
+    check_edit(program.find(U"-> int32"), 1, U"");
+});
+
+MAYFLY_ADD_TESTCASE("comments and strings", [] {
+    // opening a comment damages everything up to where it ends
+    check_edit(program.find(U"let b"), 0, U"/*");
+    check_edit(program.find(U"/* a block"), 2, U"");
+    check_edit(program.find(U"block comment */"), 0, U"*/ let d;");
+    check_edit(program.find(U"// a comment"), 2, U"");
+    check_edit(program.find(U"\"; // a comment"), 0, U"\" + \"");
+});
+
+MAYFLY_ADD_TESTCASE("every position", [] {
+    for (std::uint32_t offset = 0; offset <= program.size(); ++offset)
+    {
+        for (std::u32string replacement : { U"", U" ", U"x", U"-", U">", U"\n", U"/", U"*" })
+        {
+            for (std::uint32_t removed = 0; removed <= 2 && offset + removed <= program.size(); ++removed)
+            {
+                try
+                {
+                    check_edit(offset, removed, replacement);
+                }
+
+                // the edit has made the program invalid; the old tokens must have been left alone
+                catch (reaver::exception &)
+                {
+                    auto tokens = lex(program);
+                    auto text = program;
+                    text_edit edit{ offset, offset + removed, replacement };
+                    apply_edit(text, edit);
+                    MAYFLY_CHECK_THROWS_TYPE(reaver::exception, relex(tokens, text, edit));
+                    MAYFLY_CHECK(tokens == lex(program));
+                }
+            }
+        }
+    }
+});
+
+MAYFLY_ADD_TESTCASE("unchanged tokens are moved", [] {
+    auto tokens = lex(program);
+    auto text = program;
+    text_edit edit{ 0, 6, U"module" };
+    apply_edit(text, edit);
+
+    auto change = relex(tokens, text, edit);
+    MAYFLY_CHECK(change.first == 0);
+    MAYFLY_CHECK(change.removed == 1);
+    MAYFLY_CHECK(change.inserted == 1);
+
+    // nothing to relex at all
+    edit = { 0, 0, U"  " };
+    apply_edit(text, edit);
+    change = relex(tokens, text, edit);
+    MAYFLY_CHECK(change.removed == 0);
+    MAYFLY_CHECK(change.inserted == 0);
+    MAYFLY_CHECK(tokens == lex(text));
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -0,0 +1,144 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <reaver/mayfly.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::lexer;
+
+namespace
+{
+std::vector<token> lex_serially(const std::u32string & program)
+{
+    std::vector<token> tokens;
+    std::copy(iterator{ program.begin(), program.end(), engine::synchronous }, iterator{}, std::back_inserter(tokens));
+    return tokens;
+}
+
+// every newline is a candidate for a split with pieces this small, which is where the lexer state matters
+const std::size_t piece_sizes[] = { 1, 2, 3, 7, 64, default_piece_size };
+}
+
+MAYFLY_BEGIN_SUITE("lexer");
+MAYFLY_BEGIN_SUITE("parallel");
+
+MAYFLY_ADD_TESTCASE("same tokens as the serial lexer", [] {
+    std::u32string program = UR"(module foo
+{
+    // a line comment, with a "string" and /* a block comment */ in it
+    let a = "a string\
+with a broken line, // not a comment\
+and /* not a comment either";
+
+    /* a block comment
+     * with // a line comment and a "string
+     */
+    let b = λ(x : int32) -> int32 => x * 2;
+    /*/ still a comment
+    */ let c = "\"\
+    "; let d = a/b; /**/
+    let e = 1;
+}
+)";
+
+    auto expected = lex_serially(program);
+
+    for (auto piece_size : piece_sizes)
+    {
+        MAYFLY_CHECK(lex_parallel(program.begin(), program.end(), unknown_file, piece_size) == expected);
+    }
+
+    std::vector<token> iterated;
+    std::copy(iterator{ program.begin(), program.end(), engine::parallel }, iterator{}, std::back_inserter(iterated));
+    MAYFLY_CHECK(iterated == expected);
+});
+
+MAYFLY_ADD_TESTCASE("errors", [] {
+    for (std::u32string program : { U"let a = 1;\nlet b = \"foo\nbar\";\nlet c = 2;\n", U"let a = 1;\n/* foo\nbar\n", U"let a = 1;\n#\nlet b = /* \n" })
+    {
+        std::exception_ptr expected;
+        try
+        {
+            lex_serially(program);
+        }
+        catch (...)
+        {
+            expected = std::current_exception();
+        }
+
+        MAYFLY_REQUIRE(expected);
+
+        for (auto piece_size : piece_sizes)
+        {
+            try
+            {
+                lex_parallel(program.begin(), program.end(), unknown_file, piece_size);
+                MAYFLY_CHECK(false);
+            }
+            catch (reaver::exception & ex)
+            {
+                try
+                {
+                    std::rethrow_exception(expected);
+                }
+                catch (reaver::exception & expected_ex)
+                {
+                    MAYFLY_CHECK(typeid(ex) == typeid(expected_ex));
+                }
+            }
+        }
+    }
+});
+
+MAYFLY_ADD_TESTCASE("tokens before an error", [] {
+    std::u32string program = U"let a = 1;\nlet b = 2;\n/* unterminated\n";
+
+    std::vector<token> tokens;
+    iterator it{ program.begin(), program.end(), engine::parallel };
+    MAYFLY_CHECK_THROWS_TYPE(unterminated_comment, std::copy(it, iterator{}, std::back_inserter(tokens)));
+    MAYFLY_CHECK(tokens.size() == 10);
+});
+
+MAYFLY_ADD_TESTCASE("abandoned iterator", [] {
+    // enough pieces for the helpers to still be lexing when the iterator goes away, together with the input
+    auto program = std::make_unique<std::u32string>();
+    for (std::size_t i = 0; i < 100000; ++i)
+    {
+        *program += U"let a = 1;\n";
+    }
+
+    {
+        iterator it{ program->begin(), program->end(), engine::parallel };
+        MAYFLY_CHECK(it->type == token_type::let);
+    }
+
+    program.reset();
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
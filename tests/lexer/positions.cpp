@@ -0,0 +1,71 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <reaver/mayfly.h>
+
+#include <string>
+#include <vector>
+
+#include "helpers.h"
+#include "vapor/lexer.h"
+#include "vapor/source_file.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::lexer;
+
+MAYFLY_BEGIN_SUITE("lexer");
+MAYFLY_BEGIN_SUITE("positions");
+
+MAYFLY_ADD_TESTCASE("lines and columns", [] {
+    auto & file = register_source_file("positions.vpr", U"module foo\n{\n    let bar;\n}\n");
+
+    std::vector<token> tokens;
+    std::copy(iterator{ file, engine::synchronous }, iterator{}, std::back_inserter(tokens));
+
+    MAYFLY_REQUIRE(tokens.size() == 7);
+
+    auto check = [&](std::size_t i, std::size_t line, std::size_t column) {
+        MAYFLY_CHECK(tokens[i].range.start().file == file.id());
+        auto location = tokens[i].range.start().location();
+        MAYFLY_CHECK(location.line == line);
+        MAYFLY_CHECK(location.column == column);
+    };
+
+    check(0, 1, 1);
+    check(1, 1, 8);
+    check(2, 2, 1);
+    check(3, 3, 5);
+    check(4, 3, 9);
+    check(5, 3, 12);
+    check(6, 4, 1);
+});
+
+MAYFLY_ADD_TESTCASE("unregistered sources", [] {
+    std::u32string program = U"foo";
+    iterator it{ program.begin(), program.end(), engine::synchronous };
+
+    MAYFLY_CHECK(!it->range.start().has_location());
+    MAYFLY_CHECK(it->range.end().offset == 3);
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -0,0 +1,105 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <reaver/mayfly.h>
+
+#include <algorithm>
+#include <string>
+
+#include "vapor/lexer/scan.h"
+#include "vapor/utf.h"
+
+using namespace reaver::vapor::lexer;
+
+namespace
+{
+const std::u32string inputs[] = {
+    U"",
+    U"    \t\r\n    \n\n   \t  foo",
+    U"an_identifier_that_is_much_longer_than_a_single_vector_0123456789 + bar",
+    U"12345678901234567890123456789012345678901234567890x",
+    U"a comment body without the end of it, λ and all, that goes on and on and on\nand a new line",
+    U"* / ** // *** /// *",
+};
+
+// every implementation must agree with the scalar one, on every input and every suffix of it,
+// so that both the vector loops and the scalar tails get exercised
+template<typename F>
+void compare(F && f)
+{
+    auto original = scan::selected();
+
+    for (auto set : { scan::isa::sse2, scan::isa::avx2 })
+    {
+        if (!scan::supported(set))
+        {
+            continue;
+        }
+
+        for (auto && input : inputs)
+        {
+            auto utf8 = reaver::vapor::utf8(input);
+
+            for (std::size_t i = 0; i <= input.size(); ++i)
+            {
+                scan::select(scan::isa::scalar);
+                auto expected = f(input.data() + i, input.data() + input.size(), utf8.data() + std::min(i, utf8.size()), utf8.data() + utf8.size());
+
+                scan::select(set);
+                MAYFLY_CHECK(f(input.data() + i, input.data() + input.size(), utf8.data() + std::min(i, utf8.size()), utf8.data() + utf8.size()) == expected);
+            }
+        }
+    }
+
+    scan::select(original);
+}
+}
+
+MAYFLY_BEGIN_SUITE("lexer");
+MAYFLY_BEGIN_SUITE("scan");
+
+MAYFLY_ADD_TESTCASE("character classes", [] {
+    for (auto cls : { scan::char_class::white_space, scan::char_class::identifier, scan::char_class::decimal })
+    {
+        compare([&](auto begin, auto end, auto utf8_begin, auto utf8_end) {
+            return std::make_pair(scan::skip(cls, begin, end) - begin, scan::skip(cls, utf8_begin, utf8_end) - utf8_begin);
+        });
+    }
+});
+
+MAYFLY_ADD_TESTCASE("find", [] {
+    for (auto c : { '\n', '*', '/' })
+    {
+        compare([&](auto begin, auto end, auto utf8_begin, auto utf8_end) {
+            return std::make_pair(scan::find(c, begin, end) - begin, scan::find(c, utf8_begin, utf8_end) - utf8_begin);
+        });
+    }
+});
+
+MAYFLY_ADD_TESTCASE("code points", [] {
+    MAYFLY_CHECK(scan::count_code_points(u8"λ → x", u8"λ → x" + std::char_traits<char>::length(u8"λ → x")) == 5);
+
+    compare([&](auto, auto, auto utf8_begin, auto utf8_end) { return scan::count_code_points(utf8_begin, utf8_end); });
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -0,0 +1,124 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <reaver/mayfly.h>
+
+#include <string>
+#include <vector>
+
+#include "vapor/lexer.h"
+#include "vapor/lexer/tables.h"
+
+using namespace reaver::vapor::lexer;
+
+namespace
+{
+// what the lexer used to do with the unordered maps
+operator_match reference_match(char32_t first, char32_t second, char32_t third)
+{
+    auto one = symbols1.find(first);
+    auto two = symbols2.find(first);
+
+    if (two != symbols2.end())
+    {
+        auto three = symbols3.find(first);
+        if (three != symbols3.end() && three->second.count(second) && three->second.at(second).count(third))
+        {
+            return { three->second.at(second).at(third), 3 };
+        }
+
+        if (two->second.count(second))
+        {
+            return { two->second.at(second), 2 };
+        }
+    }
+
+    if (one != symbols1.end())
+    {
+        return { one->second, 1 };
+    }
+
+    return { token_type::none, 0 };
+}
+}
+
+MAYFLY_BEGIN_SUITE("lexer");
+MAYFLY_BEGIN_SUITE("tables");
+
+MAYFLY_ADD_TESTCASE("keywords", [] {
+    MAYFLY_CHECK(keyword_count == keywords.size());
+
+    for (auto && kw : keywords)
+    {
+        auto found = find_keyword(kw.first);
+        MAYFLY_REQUIRE(found);
+        MAYFLY_CHECK(found->type == kw.second);
+        MAYFLY_CHECK(found->spelling == kw.first);
+    }
+
+    for (auto && str : { U"", U"i", U"lets", U"Let", U"els", U"elsewhere", U"truefalse", U"typeclasses", U"function_", U"λ" })
+    {
+        MAYFLY_CHECK(!find_keyword(str));
+    }
+});
+
+MAYFLY_ADD_TESTCASE("operators", [] {
+    // all the interesting characters, and a couple of ones that aren't
+    std::u32string alphabet = U"a0 _\"";
+    for (auto && entry : symbols1)
+    {
+        alphabet.push_back(entry.first);
+    }
+
+    for (char32_t first : alphabet)
+    {
+        for (char32_t second : alphabet + U'\0')
+        {
+            for (char32_t third : alphabet + U'\0')
+            {
+                auto expected = reference_match(first, second, third);
+                auto actual = match_operator(first, second, third);
+
+                MAYFLY_CHECK(actual.type == expected.type);
+                MAYFLY_CHECK(actual.length == expected.length);
+            }
+        }
+    }
+});
+
+MAYFLY_ADD_TESTCASE("spellings", [] {
+    for (auto && entry : symbols1)
+    {
+        MAYFLY_CHECK(token_spellings[+entry.second] == std::u32string(1, entry.first));
+    }
+
+    for (auto && first : symbols2)
+    {
+        for (auto && second : first.second)
+        {
+            MAYFLY_CHECK(token_spellings[+second.second] == std::u32string{ first.first, second.first });
+        }
+    }
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
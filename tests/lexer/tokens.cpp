@@ -0,0 +1,50 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <reaver/mayfly.h>
+
+#include <string>
+#include <vector>
+
+#include "helpers.h"
+#include "vapor/lexer.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::lexer;
+
+MAYFLY_BEGIN_SUITE("lexer");
+MAYFLY_BEGIN_SUITE("tokens");
+
+MAYFLY_ADD_TESTCASE("walking lexed tokens", [] {
+    std::u32string program = U"let foo = { 1 + bar };";
+
+    std::vector<token> lexed;
+    std::copy(iterator{ program.begin(), program.end(), engine::synchronous }, iterator{}, std::back_inserter(lexed));
+
+    std::vector<token> walked;
+    std::copy(iterator{ lexed }, iterator{}, std::back_inserter(walked));
+
+    MAYFLY_CHECK(walked == lexed);
+    MAYFLY_CHECK(!iterator{ std::vector<token>{} });
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -0,0 +1,108 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <reaver/mayfly.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "helpers.h"
+#include "vapor/lexer.h"
+#include "vapor/source_file.h"
+#include "vapor/utf8_iterator.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::lexer;
+
+namespace
+{
+std::u32string decode(const std::string & str)
+{
+    return { utf8_iterator{ str.data(), str.data() + str.size() }, utf8_iterator{ str.data() + str.size(), str.data() + str.size() } };
+}
+
+std::vector<token> lex(const std::string & str)
+{
+    std::vector<token> tokens;
+    std::copy(iterator{ utf8_iterator{ str.data(), str.data() + str.size() },
+                  utf8_iterator{ str.data() + str.size(), str.data() + str.size() },
+                  unknown_file,
+                  engine::synchronous },
+        iterator{},
+        std::back_inserter(tokens));
+    return tokens;
+}
+}
+
+MAYFLY_BEGIN_SUITE("lexer");
+MAYFLY_BEGIN_SUITE("utf-8");
+
+MAYFLY_ADD_TESTCASE("decoding", [] {
+    MAYFLY_CHECK(decode("abc") == U"abc");
+    MAYFLY_CHECK(decode(u8"λ(x) => ∀ 𝔸") == U"λ(x) => ∀ 𝔸");
+});
+
+MAYFLY_ADD_TESTCASE("malformed sequences", [] {
+    // a lone continuation byte, a truncated sequence, an overlong encoding and a surrogate
+    MAYFLY_CHECK(decode("a\x80z") == U"a�z");
+    MAYFLY_CHECK(decode("a\xCE") == U"a�");
+    MAYFLY_CHECK(decode("\xC0\xAF") == U"��");
+    MAYFLY_CHECK(decode("\xED\xA0\x80") == U"���");
+});
+
+MAYFLY_ADD_TESTCASE("same tokens as UTF-32", [] {
+    std::string program = u8"let entry = λ(arg : int32) -> int32 => \"ünïcödé\" + arg; // λ in a comment";
+    std::u32string program32 = utf32(program);
+
+    std::vector<token> expected;
+    std::copy(iterator{ program32.begin(), program32.end(), engine::synchronous }, iterator{}, std::back_inserter(expected));
+
+    MAYFLY_CHECK(lex(program) == expected);
+});
+
+MAYFLY_ADD_TESTCASE("mapped file", [] {
+    auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vapor-%%%%-%%%%.vprl");
+
+    {
+        std::ofstream out{ path.string() };
+        out << u8"module foo\n{\n    let λ = 1;\n}\n";
+    }
+
+    auto & file = open_source_file(path.string());
+    boost::filesystem::remove(path);
+
+    MAYFLY_REQUIRE(file.is_utf8());
+
+    std::vector<token> tokens;
+    std::copy(iterator{ file, engine::synchronous }, iterator{}, std::back_inserter(tokens));
+
+    MAYFLY_REQUIRE(tokens.size() == 9);
+    MAYFLY_CHECK(tokens[4].string == U"λ");
+    MAYFLY_CHECK(tokens[5].range.start().location().line == 3);
+    MAYFLY_CHECK(tokens[5].range.start().location().column == 11);
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
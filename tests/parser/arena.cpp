@@ -0,0 +1,128 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <reaver/mayfly.h>
+
+#include "helpers.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::parser;
+
+namespace
+{
+const std::u32string program = UR"(module arena
+{
+    let mn = struct { let m : int32; let n : int32; };
+
+    function f(a : int32, b : int32) -> int32
+    {
+        if (a == 0)
+        {
+            return b * -a + f(a - 1, mn{ a, b + 1 });
+        }
+
+        return a + b;
+    }
+
+    let l = λ(x : int32) -> int32 => f(x, x + 1) - 1;
+})";
+
+module parse(node_allocation allocation)
+{
+    context ctx;
+    ctx.begin = lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous };
+    ctx.allocation = allocation;
+    return parse_module(ctx);
+}
+}
+
+MAYFLY_BEGIN_SUITE("parser");
+MAYFLY_BEGIN_SUITE("arena");
+
+MAYFLY_ADD_TESTCASE("blocks are reused", [] {
+    arena a;
+
+    auto first = a.allocate(48);
+    auto second = a.allocate(48);
+    MAYFLY_CHECK(first != second);
+    MAYFLY_CHECK(reinterpret_cast<std::uintptr_t>(first) % arena::alignment == 0);
+    MAYFLY_CHECK(reinterpret_cast<std::uintptr_t>(second) % arena::alignment == 0);
+
+    a.deallocate(first, 48);
+    MAYFLY_CHECK(a.allocate(40) == first);
+    MAYFLY_CHECK(a.allocate(48) != first);
+});
+
+MAYFLY_ADD_TESTCASE("nodes come from the innermost scope", [] {
+    arena outer;
+    arena inner;
+
+    arena_scope outer_scope{ &outer };
+    auto from_outer = allocate_node(32);
+    auto outer_bytes = outer.allocated_bytes();
+    MAYFLY_CHECK(outer_bytes != 0);
+
+    {
+        arena_scope inner_scope{ &inner };
+        auto from_inner = allocate_node(32);
+        auto inner_bytes = inner.allocated_bytes();
+        MAYFLY_CHECK(inner_bytes != 0);
+        MAYFLY_CHECK(outer.allocated_bytes() == outer_bytes);
+
+        arena_scope heap_scope{ nullptr };
+        auto from_heap = allocate_node(32);
+        MAYFLY_CHECK(inner.allocated_bytes() == inner_bytes);
+        MAYFLY_CHECK(outer.allocated_bytes() == outer_bytes);
+
+        deallocate_node(from_heap);
+        deallocate_node(from_inner);
+    }
+
+    // outside of the inner scope, the block goes back to the free list of the arena it came from
+    deallocate_node(from_outer);
+    MAYFLY_CHECK(allocate_node(32) == from_outer);
+});
+
+MAYFLY_ADD_TESTCASE("arena and heap modules are the same", [] {
+    auto in_arena = parse(node_allocation::arena);
+    auto on_heap = parse(node_allocation::heap);
+
+    MAYFLY_REQUIRE(in_arena.memory);
+    MAYFLY_CHECK(in_arena.memory->allocated_bytes() != 0);
+    MAYFLY_CHECK(!on_heap.memory);
+
+    MAYFLY_CHECK(in_arena.range == on_heap.range);
+    MAYFLY_CHECK(in_arena.name == on_heap.name);
+    MAYFLY_CHECK(in_arena.statements == on_heap.statements);
+});
+
+MAYFLY_ADD_TESTCASE("modules outlive the scope they were parsed in", [] {
+    auto mod = parse(node_allocation::arena);
+    auto copy = mod;
+    auto moved = std::move(mod);
+
+    MAYFLY_CHECK(copy.statements == moved.statements);
+    MAYFLY_CHECK(copy.memory == moved.memory);
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
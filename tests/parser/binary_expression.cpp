@@ -103,5 +103,55 @@ MAYFLY_ADD_TESTCASE("lower-higher-lower precedence, left associative",
         },
         [](auto && ctx) { return parse_expression(ctx); }));
 
+MAYFLY_ADD_TESTCASE("compound assignment, right associative",
+    test(UR"(1 %= 2 -= 3;)",
+        expression{ { 0, 11 },
+            binary_expression{ { 0, 11 },
+                { lexer::token_type::modulo_assignment, UR"(%=)", { 2, 4 } },
+                { { 0, 1 }, integer_literal{ { 0, 1 }, { lexer::token_type::integer, UR"(1)", { 0, 1 } }, {} } },
+                { { 5, 11 },
+                    binary_expression{ { 5, 11 },
+                        { lexer::token_type::minus_assignment, UR"(-=)", { 7, 9 } },
+                        { { 5, 6 }, integer_literal{ { 5, 6 }, { lexer::token_type::integer, UR"(2)", { 5, 6 } }, {} } },
+                        { { 10, 11 }, integer_literal{ { 10, 11 }, { lexer::token_type::integer, UR"(3)", { 10, 11 } }, {} } } } } }
+
+        },
+        [](auto && ctx) { return parse_expression(ctx); }));
+
+MAYFLY_ADD_TESTCASE("long chain", [] {
+    std::u32string program = U"0";
+    for (std::size_t i = 1; i <= 5000; ++i)
+    {
+        program += U" + 0";
+    }
+    program += U";";
+
+    context ctx;
+    ctx.begin = lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous };
+    auto expr = parse_expression(ctx);
+
+    // left associative, so the tree leans left all the way down
+    std::size_t depth = 0;
+    const expression * current = &expr;
+    for (bool done = false; !done;)
+    {
+        reaver::visit(reaver::make_overload_set(
+                  [&](const binary_expression & bin) {
+                      MAYFLY_REQUIRE(bin.range == range_type{ 0, program.size() - 1 - 4 * depth });
+                      MAYFLY_REQUIRE(bin.rhs.range == range_type{ bin.range.end() - 1, bin.range.end() });
+                      current = &bin.lhs;
+                      ++depth;
+                      return reaver::unit{};
+                  },
+                  [&](const auto &) {
+                      done = true;
+                      return reaver::unit{};
+                  }),
+            current->expression_value);
+    }
+
+    MAYFLY_CHECK(depth == 5000);
+});
+
 MAYFLY_END_SUITE;
 MAYFLY_END_SUITE;
@@ -225,6 +225,45 @@ MAYFLY_ADD_TESTCASE("two parameters, explicit type, simple body",
                             {} } } } } } } },
         [](auto && ctx) { return parse_function_definition(ctx); }));
 
+namespace
+{
+function_definition parse_with(const std::u32string & program, body_parsing bodies)
+{
+    context ctx;
+    ctx.begin = lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous };
+    ctx.bodies = bodies;
+    return parse_function_definition(ctx);
+}
+}
+
+MAYFLY_ADD_TESTCASE("deferred body", [] {
+    std::u32string program = UR"(function foo(a : int) { if (a == 0) { return λ() { => a }; } => a })";
+
+    auto eager = parse_with(program, body_parsing::eager);
+    auto deferred = parse_with(program, body_parsing::deferred);
+
+    MAYFLY_CHECK(!eager.body->deferred);
+    MAYFLY_REQUIRE(deferred.body->deferred);
+    MAYFLY_CHECK(deferred.body->block_value.empty());
+    MAYFLY_CHECK(!deferred.body->value_expression);
+
+    MAYFLY_CHECK(deferred.range == eager.range);
+    MAYFLY_CHECK(deferred.body->range == eager.body->range);
+    MAYFLY_CHECK(parsed(*deferred.body).block_value.size() == 1);
+    MAYFLY_CHECK(deferred == eager);
+});
+
+MAYFLY_ADD_TESTCASE("errors in a deferred body", [] {
+    std::u32string program = UR"(function foo() { let = 1; })";
+
+    MAYFLY_CHECK_THROWS_TYPE(expectation_failure, parse_with(program, body_parsing::eager));
+
+    auto deferred = parse_with(program, body_parsing::deferred);
+    MAYFLY_CHECK_THROWS_TYPE(expectation_failure, parsed(*deferred.body));
+
+    MAYFLY_CHECK_THROWS_TYPE(expectation_failure, parse_with(UR"(function foo() { { })", body_parsing::deferred));
+});
+
 MAYFLY_END_SUITE;
 MAYFLY_END_SUITE;
 MAYFLY_END_SUITE;
@@ -55,7 +55,7 @@ namespace vapor
                 return [program = std::move(program), expected = std::move(expected), parser = std::move(parser)]()
                 {
                     context ctx;
-                    ctx.begin = lexer::iterator{ program.begin(), program.end() };
+                    ctx.begin = lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous };
 
                     std::stringstream ss;
                     for (auto it = ctx.begin; it != ctx.end; ++it)
@@ -0,0 +1,162 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <string>
+
+#include <reaver/mayfly.h>
+
+#include "helpers.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::parser;
+
+namespace
+{
+const std::u32string program = UR"(module incremental
+{
+    let s = struct { let m : int32; let n : int32; };
+
+    function f(a : int32) -> int32
+    {
+        if (a == 0)
+        {
+            return s{ a, 1 };
+        }
+        else
+        {
+            return f(a - 1) * a;
+        }
+    }
+
+    let l = λ(x : int32) -> int32 { return x * x - 2; };
+    function g() => 3
+    f(1, s{ 1, 2 }), l(2);
+    let t = g() + f(2) * 4;
+
+    function h(b : int32) -> int32 { return b; }
+    let u = h(5);
+    if (u == 5) { h(1); }
+    let w = 1;
+}
+)";
+
+module parse(const std::u32string & text, body_parsing bodies = body_parsing::eager)
+{
+    context ctx;
+    ctx.begin = lexer::iterator{ text.begin(), text.end(), lexer::engine::synchronous };
+    ctx.bodies = bodies;
+    return parse_module(ctx);
+}
+
+bool equal(const module & lhs, const module & rhs)
+{
+    return lhs.range == rhs.range && lhs.name == rhs.name && lhs.statements == rhs.statements;
+}
+
+// returns whether the reparse agreed with parsing the edited text from scratch, including about whether it's valid
+bool check_edit(const lexer::text_edit & edit, body_parsing bodies)
+{
+    auto text = program;
+    lexer::apply_edit(text, edit);
+
+    reaver::optional<module> full;
+    try
+    {
+        full = parse(text);
+    }
+
+    catch (...)
+    {
+    }
+
+    try
+    {
+        auto reparsed = reparse(parse(program, bodies), text, edit);
+        return full && equal(*full, reparsed);
+    }
+
+    catch (...)
+    {
+        return !full;
+    }
+}
+}
+
+MAYFLY_BEGIN_SUITE("parser");
+MAYFLY_BEGIN_SUITE("incremental");
+
+MAYFLY_ADD_TESTCASE("reparsing matches a full parse for edits everywhere", [] {
+    const std::u32string replacements[] = { U"", U" ", U"\n", U"1", U"x", U";", U"}", U"else { h(2); }" };
+
+    std::size_t mismatches = 0;
+    for (std::uint32_t begin = 0; begin <= program.size(); ++begin)
+    {
+        for (std::uint32_t length = 0; length < 3 && begin + length <= program.size(); ++length)
+        {
+            for (auto && replacement : replacements)
+            {
+                if (!check_edit({ begin, begin + length, replacement }, body_parsing::eager))
+                {
+                    ++mismatches;
+                }
+            }
+        }
+    }
+
+    MAYFLY_CHECK(mismatches == 0);
+});
+
+MAYFLY_ADD_TESTCASE("deferred bodies after the edit are moved", [] {
+    auto at = static_cast<std::uint32_t>(program.find(U"function f"));
+
+    MAYFLY_CHECK(check_edit({ at, at, U"let v = 1;\n    " }, body_parsing::deferred));
+    MAYFLY_CHECK(check_edit({ at, at + 11, U"function ff" }, body_parsing::deferred));
+    MAYFLY_CHECK(check_edit({ 0, 0, U"\n\n" }, body_parsing::deferred));
+});
+
+MAYFLY_ADD_TESTCASE("statements away from the edit are not parsed again", [] {
+    // the same length, so the statements after the edit don't even move
+    auto at = static_cast<std::uint32_t>(program.find(U"function g() => 3"));
+    lexer::text_edit edit{ at + 16, at + 17, U"4" };
+
+    auto text = program;
+    lexer::apply_edit(text, edit);
+
+    auto previous = parse(program, body_parsing::deferred);
+    auto reparsed = reparse(previous, text, edit);
+    MAYFLY_CHECK(equal(reparsed, parse(text)));
+
+    // a deferred body is only shared by copies of the block it came from
+    auto body = [](const module & mod, std::size_t index) { return reaver::get<function_definition>(mod.statements[index].statement_value).body->deferred; };
+    MAYFLY_REQUIRE(body(previous, 1));
+    MAYFLY_CHECK(body(reparsed, 1) == body(previous, 1));
+    MAYFLY_REQUIRE(body(previous, 6));
+    MAYFLY_CHECK(body(reparsed, 6) == body(previous, 6));
+});
+
+MAYFLY_ADD_TESTCASE("edits before the module are rejected", [] {
+    auto text = U"\n" + program;
+    auto previous = parse(text);
+    MAYFLY_CHECK_THROWS_TYPE(reaver::exception, reparse(previous, program, { 0, 1, U"" }));
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -216,5 +216,22 @@ MAYFLY_ADD_TESTCASE("two parameters, explicit type, simple body",
                             {} } } } } } } },
         &parse_lambda_expression));
 
+MAYFLY_ADD_TESTCASE("deferred body", [] {
+    std::u32string program = UR"(λ(a : int) { { let c = a; } let b = λ() { => a }; => b })";
+
+    context eager_ctx;
+    eager_ctx.begin = lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous };
+    auto deferred_ctx = eager_ctx;
+    deferred_ctx.bodies = body_parsing::deferred;
+
+    auto eager = parse_lambda_expression(eager_ctx);
+    auto deferred = parse_lambda_expression(deferred_ctx);
+
+    MAYFLY_REQUIRE(deferred.body.deferred);
+    MAYFLY_CHECK(deferred.body.block_value.empty());
+    MAYFLY_CHECK(deferred.range == eager.range);
+    MAYFLY_CHECK(deferred == eager);
+});
+
 MAYFLY_END_SUITE;
 MAYFLY_END_SUITE;
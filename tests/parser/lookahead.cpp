@@ -0,0 +1,110 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <string>
+
+#include <reaver/mayfly.h>
+
+#include "helpers.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::parser;
+
+namespace
+{
+const std::u32string program = U"let a = b + c * f(d, 1);";
+
+context make_context(const std::u32string & text)
+{
+    context ctx;
+    ctx.begin = lexer::iterator{ text.begin(), text.end(), lexer::engine::synchronous };
+    return ctx;
+}
+}
+
+MAYFLY_BEGIN_SUITE("parser");
+MAYFLY_BEGIN_SUITE("lookahead");
+
+MAYFLY_ADD_TESTCASE("peeking ahead doesn't consume tokens", [] {
+    auto ctx = make_context(program);
+
+    MAYFLY_REQUIRE(peek(ctx, 3));
+    MAYFLY_CHECK(peek(ctx, 3)->type == lexer::token_type::identifier);
+    MAYFLY_CHECK(peek(ctx, 3)->string == U"b");
+    MAYFLY_CHECK(peek(ctx, 2)->type == lexer::token_type::assign);
+    MAYFLY_CHECK(peek(ctx)->type == lexer::token_type::let);
+
+    // the tokens read ahead are parsed like any others
+    auto fresh = make_context(program);
+    MAYFLY_CHECK(parse_declaration(ctx) == parse_declaration(fresh));
+    expect(ctx, lexer::token_type::semicolon);
+    MAYFLY_CHECK(!peek(ctx));
+    MAYFLY_CHECK(!peek(ctx, 1));
+});
+
+MAYFLY_ADD_TESTCASE("looking too far ahead is an error", [] {
+    auto ctx = make_context(program);
+    MAYFLY_CHECK_THROWS_TYPE(reaver::exception, peek(ctx, lookahead_buffer::capacity));
+});
+
+MAYFLY_ADD_TESTCASE("rewinding reparses the same tokens", [] {
+    auto ctx = make_context(program);
+    expect(ctx, lexer::token_type::let);
+    expect(ctx, lexer::token_type::identifier);
+    expect(ctx, lexer::token_type::assign);
+
+    auto point = mark(ctx);
+    auto first = parse_expression(ctx);
+    MAYFLY_CHECK(peek(ctx, lexer::token_type::semicolon));
+
+    rewind(ctx, point);
+    MAYFLY_CHECK(peek(ctx)->string == U"b");
+    MAYFLY_CHECK(parse_expression(ctx) == first);
+    MAYFLY_CHECK(peek(ctx, lexer::token_type::semicolon));
+});
+
+MAYFLY_ADD_TESTCASE("rewinding past the buffer is an error", [] {
+    std::u32string text;
+    for (std::size_t i = 0; i < lookahead_buffer::capacity + 1; ++i)
+    {
+        text += U"a ";
+    }
+
+    auto ctx = make_context(text);
+    auto point = mark(ctx);
+    for (std::size_t i = 0; i < lookahead_buffer::capacity; ++i)
+    {
+        expect(ctx, lexer::token_type::identifier);
+    }
+
+    // the oldest token is still there
+    rewind(ctx, point);
+
+    for (std::size_t i = 0; i < lookahead_buffer::capacity + 1; ++i)
+    {
+        expect(ctx, lexer::token_type::identifier);
+    }
+
+    MAYFLY_CHECK_THROWS_TYPE(reaver::exception, rewind(ctx, point));
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -0,0 +1,145 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <string>
+
+#include <reaver/future.h>
+#include <reaver/mayfly.h>
+
+#include "helpers.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::parser;
+
+namespace
+{
+// enough statements of every kind allowed at the module scope to be split into many runs
+std::u32string generate_program(std::size_t count)
+{
+    std::u32string ret = U"module parallel\n{\n";
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto n = utf32(std::to_string(i));
+
+        switch (i % 5)
+        {
+            case 0:
+                ret += U"    let s" + n + U" = struct { let m : int32; let n : int32; };\n";
+                break;
+
+            case 1:
+                ret += U"    function f" + n + U"(a : int32) -> int32\n    {\n        if (a == 0)\n        {\n            return s0{ a, "
+                    + n + U" };\n        }\n        else\n        {\n            return f" + n + U"(a - 1) * a + " + n + U";\n        }\n    }\n";
+                break;
+
+            case 2:
+                ret += U"    let l" + n + U" = λ(x : int32) -> int32 { return x * x - " + n + U"; };\n";
+                break;
+
+            case 3:
+                ret += U"    function g" + n + U"() => " + n + U"\n";
+                break;
+
+            case 4:
+                ret += U"    f1(" + n + U", s0{ 1, 2 }), l2(" + n + U");\n";
+                break;
+        }
+    }
+
+    return ret + U"}\n";
+}
+
+module parse(const std::u32string & program, module_parsing parsing)
+{
+    context ctx;
+    ctx.begin = lexer::iterator{ program.begin(), program.end(), lexer::engine::synchronous };
+    ctx.parsing = parsing;
+    return parse_module(ctx);
+}
+
+template<typename F>
+void with_threads(F && f)
+{
+    auto original = reaver::default_executor();
+    reaver::default_executor(reaver::make_executor<reaver::thread_pool>(4));
+
+    try
+    {
+        f();
+    }
+
+    catch (...)
+    {
+        reaver::default_executor(original);
+        throw;
+    }
+
+    reaver::default_executor(original);
+}
+}
+
+MAYFLY_BEGIN_SUITE("parser");
+MAYFLY_BEGIN_SUITE("module");
+
+MAYFLY_ADD_TESTCASE("parallel parsing keeps the source order", [] {
+    with_threads([] {
+        auto program = generate_program(2000);
+        auto sequential = parse(program, module_parsing::sequential);
+        auto parallel = parse(program, module_parsing::parallel);
+
+        MAYFLY_CHECK(sequential.statement_memory.empty());
+        MAYFLY_CHECK(parallel.statement_memory.size() > 1);
+
+        MAYFLY_CHECK(sequential.range == parallel.range);
+        MAYFLY_CHECK(sequential.name == parallel.name);
+        MAYFLY_REQUIRE(sequential.statements.size() == 2000);
+        MAYFLY_CHECK(sequential.statements == parallel.statements);
+    });
+});
+
+MAYFLY_ADD_TESTCASE("small modules are parsed sequentially", [] {
+    auto program = generate_program(5);
+    auto parallel = parse(program, module_parsing::parallel);
+
+    MAYFLY_CHECK(parallel.statement_memory.empty());
+    MAYFLY_CHECK(parallel.statements == parse(program, module_parsing::sequential).statements);
+});
+
+MAYFLY_ADD_TESTCASE("errors are reported as if parsed sequentially", [] {
+    with_threads([] {
+        auto program = generate_program(2000);
+        program.insert(program.size() / 2, U";");
+
+        MAYFLY_CHECK_THROWS_TYPE(expectation_failure, parse(program, module_parsing::sequential));
+        MAYFLY_CHECK_THROWS_TYPE(expectation_failure, parse(program, module_parsing::parallel));
+
+        program = generate_program(2000);
+        program.pop_back();
+        program.pop_back();
+
+        MAYFLY_CHECK_THROWS_TYPE(expectation_failure, parse(program, module_parsing::sequential));
+        MAYFLY_CHECK_THROWS_TYPE(expectation_failure, parse(program, module_parsing::parallel));
+    });
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
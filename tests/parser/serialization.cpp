@@ -0,0 +1,174 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+#include <reaver/mayfly.h>
+
+#include "helpers.h"
+
+using namespace reaver::vapor;
+using namespace reaver::vapor::parser;
+
+namespace
+{
+const std::u32string program = UR"(module serialization
+{
+    let mn = struct { let m : int32; let n : int32; };
+    let tc = with (T : type) typeclass { function foo(x : T) -> int32; };
+
+    function f(a : int32, b : int32) -> int32
+    {
+        if (a.m == 0)
+        {
+            return b * -a + f(a - 1, mn{ a, b + 1 });
+        }
+        else if (!b && true)
+        {
+            { let c = b; }
+        }
+        else
+        {
+            => a
+        }
+
+        return a + b;
+    }
+
+    let l = λ(x : int32) -> int32 => f(x, x + 1) - 1;
+    let i = import foo.bar;
+})";
+
+ast parse(const std::u32string & source, body_parsing bodies = body_parsing::eager)
+{
+    return ast{ lexer::iterator{ source.begin(), source.end(), lexer::engine::synchronous }, {}, node_allocation::arena, module_parsing::sequential, bodies };
+}
+
+bool equal(const ast & lhs, const ast & rhs)
+{
+    auto lhs_it = lhs.begin();
+    auto rhs_it = rhs.begin();
+
+    for (; lhs_it != lhs.end() && rhs_it != rhs.end(); ++lhs_it, ++rhs_it)
+    {
+        if (!(lhs_it->range == rhs_it->range && lhs_it->name == rhs_it->name && lhs_it->statements == rhs_it->statements))
+        {
+            return false;
+        }
+    }
+
+    return lhs_it == lhs.end() && rhs_it == rhs.end();
+}
+}
+
+MAYFLY_BEGIN_SUITE("parser");
+MAYFLY_BEGIN_SUITE("serialization");
+
+MAYFLY_ADD_TESTCASE("round trip", [] {
+    auto parsed = parse(program + program);
+    auto loaded = deserialize(serialize(parsed));
+
+    MAYFLY_CHECK(equal(parsed, loaded));
+    MAYFLY_CHECK(serialize(loaded) == serialize(parsed));
+});
+
+MAYFLY_ADD_TESTCASE("identifiers keep their IDs", [] {
+    auto loaded = deserialize(serialize(parse(program)));
+    auto & name = loaded.begin()->name.id_expression_value.front().value;
+
+    MAYFLY_CHECK(name.id == lexer::identifier_id{ U"serialization" });
+});
+
+MAYFLY_ADD_TESTCASE("deferred bodies are stored parsed", [] {
+    auto deferred = parse(program, body_parsing::deferred);
+    auto eager = parse(program);
+
+    MAYFLY_CHECK(serialize(deferred) == serialize(eager));
+    MAYFLY_CHECK(equal(deserialize(serialize(deferred)), eager));
+});
+
+MAYFLY_ADD_TESTCASE("loaded tokens refer to the string table", [] {
+    auto data = std::make_unique<std::string>(serialize(parse(UR"(module literals
+{
+    let a = 123456789012345678901234567890;
+    let b = 123456789012345678901234567890;
+})")));
+    auto loaded = deserialize(*data);
+    data.reset();
+
+    auto literal = [&](std::size_t index) -> const lexer::token & {
+        auto & decl = reaver::get<declaration>(loaded.begin()->statements[index].statement_value);
+        return reaver::get<parser::literal<lexer::token_type::integer>>(decl.rhs->expression_value).value;
+    };
+
+    // equal strings are stored once, so tokens that share a string must share its storage,
+    // which also outlives the serialized data
+    MAYFLY_CHECK(literal(0).string.data() == literal(1).string.data());
+    MAYFLY_CHECK(std::u32string_view{ literal(0).string } == U"123456789012345678901234567890");
+});
+
+MAYFLY_ADD_TESTCASE("positions refer to the given file", [] {
+    auto & file = register_source_file("serialization.vprl", program);
+    auto loaded = deserialize(serialize(parse(program)), file.id());
+
+    MAYFLY_CHECK(loaded.begin()->range.start().file == file.id());
+    MAYFLY_CHECK(loaded.begin()->range.end().file == file.id());
+});
+
+MAYFLY_ADD_TESTCASE("invalid data", [] {
+    auto data = serialize(parse(program));
+
+    MAYFLY_CHECK_THROWS_TYPE(invalid_serialized_ast, deserialize(""));
+    MAYFLY_CHECK_THROWS_TYPE(invalid_serialized_ast, deserialize("VAST"));
+    MAYFLY_CHECK_THROWS_TYPE(invalid_serialized_ast, deserialize(data.substr(0, data.size() / 2)));
+    MAYFLY_CHECK_THROWS_TYPE(invalid_serialized_ast, deserialize(data + '\0'));
+});
+
+MAYFLY_ADD_TESTCASE("cache", [] {
+    char directory[] = "/tmp/vapor-ast-cache-XXXXXX";
+    MAYFLY_REQUIRE(::mkdtemp(directory));
+
+    ast_cache cache{ directory };
+    auto & file = register_source_file("cached.vprl", program);
+    auto & changed = register_source_file("changed.vprl", program + U" ");
+
+    MAYFLY_CHECK(!cache.load(file));
+
+    cache.store(file, parse(program));
+    auto loaded = cache.load(file);
+    MAYFLY_REQUIRE(loaded);
+    MAYFLY_CHECK(equal(*loaded, parse(program)));
+    MAYFLY_CHECK(!cache.load(changed));
+
+    // an entry found under a file's hash, but parsed from different contents, is a miss
+    MAYFLY_REQUIRE(std::rename(cache.path(file).c_str(), cache.path(changed).c_str()) == 0);
+    MAYFLY_CHECK(!cache.load(changed));
+
+    std::remove(cache.path(changed).c_str());
+    ::rmdir(directory);
+});
+
+MAYFLY_END_SUITE;
+MAYFLY_END_SUITE;
@@ -0,0 +1,182 @@
+/**
+ * Vapor Compiler Licence
+ *
+ * Copyright © 2017 Michał "Griwes" Dominiak
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation is required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ **/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <reaver/mayfly.h>
+
+#include "vapor/work_stealing_executor.h"
+
+using namespace reaver::vapor;
+
+namespace
+{
+// lets the tasks wait for something the test does
+class gate
+{
+public:
+    void open()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ _lock };
+            _open = true;
+        }
+        _opened.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock{ _lock };
+        _opened.wait(lock, [&] { return _open; });
+    }
+
+private:
+    std::mutex _lock;
+    std::condition_variable _opened;
+    bool _open = false;
+};
+}
+
+MAYFLY_BEGIN_SUITE("work stealing executor");
+
+MAYFLY_ADD_TESTCASE("every task runs exactly once", [] {
+    constexpr std::size_t roots = 1000;
+    constexpr std::size_t children = 8;
+
+    std::vector<std::atomic<std::size_t>> runs(roots * (children + 1));
+
+    {
+        auto executor = std::make_shared<work_stealing_executor>(4);
+
+        for (std::size_t i = 0; i < roots; ++i)
+        {
+            executor->push([&, executor = executor.get(), i] {
+                runs[i * (children + 1)].fetch_add(1);
+
+                for (std::size_t j = 1; j <= children; ++j)
+                {
+                    executor->push([&, i, j] { runs[i * (children + 1) + j].fetch_add(1); });
+                }
+            });
+        }
+
+        // the destructor finishes everything that's queued
+    }
+
+    std::size_t wrong = 0;
+    for (auto && count : runs)
+    {
+        wrong += count.load() != 1;
+    }
+    MAYFLY_CHECK(wrong == 0);
+});
+
+MAYFLY_ADD_TESTCASE("tasks pushed by a worker are stolen by the others", [] {
+    constexpr std::size_t children = 256;
+
+    std::atomic<std::size_t> done{ 0 };
+    std::atomic<std::size_t> ran_on_root_thread{ 0 };
+    gate all_done;
+
+    std::thread::id root_thread;
+    gate root_started;
+
+    // destroyed first, so the tasks are done with everything above
+    auto executor = std::make_shared<work_stealing_executor>(4);
+
+    // the root doesn't return before its children are done, so its worker never gets to take them back; all of them have
+    // to be stolen
+    executor->push([&] {
+        root_thread = std::this_thread::get_id();
+        root_started.open();
+
+        for (std::size_t i = 0; i < children; ++i)
+        {
+            executor->push([&] {
+                ran_on_root_thread.fetch_add(std::this_thread::get_id() == root_thread);
+                if (done.fetch_add(1) + 1 == children)
+                {
+                    all_done.open();
+                }
+            });
+        }
+
+        all_done.wait();
+    });
+
+    root_started.wait();
+    all_done.wait();
+
+    auto statistics = executor->get_statistics();
+    MAYFLY_CHECK(statistics.pushed_externally == 1);
+    MAYFLY_CHECK(statistics.pushed_locally == children);
+    MAYFLY_CHECK(statistics.stolen == children);
+    MAYFLY_CHECK(ran_on_root_thread.load() == 0);
+});
+
+MAYFLY_ADD_TESTCASE("destruction finishes queued work", [] {
+    constexpr std::size_t tasks = 100;
+
+    std::atomic<std::size_t> ran{ 0 };
+    gate blocker;
+
+    std::thread opener;
+
+    {
+        work_stealing_executor executor{ 2 };
+
+        // both workers are kept busy, so everything pushed after this stays queued until the destructor is already waiting
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            executor.push([&] {
+                blocker.wait();
+                ran.fetch_add(1);
+            });
+        }
+
+        for (std::size_t i = 0; i < tasks; ++i)
+        {
+            executor.push([&] {
+                ran.fetch_add(1);
+                // pushed while the executor is being destroyed; it still has to run
+                executor.push([&] { ran.fetch_add(1); });
+            });
+        }
+
+        opener = std::thread{ [&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            blocker.open();
+        } };
+    }
+
+    opener.join();
+
+    MAYFLY_CHECK(ran.load() == 2 + tasks * 2);
+});
+
+MAYFLY_END_SUITE;